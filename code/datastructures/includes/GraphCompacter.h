@@ -16,6 +16,27 @@ public:
 
     EdgeId getOriginalId(const Edge& edgeinCompactGraph) const;
 
+    /**
+     * Original edges that were dropped from the compact graph because they are parallel to the given original edge
+     * and have exactly the same costs. Every one of them can replace the given edge in a solution.
+     * @param originalEdgeId Preimage of a compact edge or an edge contracted into a component.
+     */
+    const std::vector<EdgeId>& getEquivalentOriginalIds(EdgeId originalEdgeId) const;
+
+    /**
+     * Merges the connected components linked by the given compact edges and rebuilds the compact graph. The
+     * preimages of the contracted edges become part of every solution, just like the blue edges of the components.
+     * @param compactEdgeIds Edges of the current compact graph. They must not close a cycle.
+     */
+    void contract(const std::vector<EdgeId>& compactEdgeIds);
+
+    /**
+     * Renumbers the connected components and rebuilds the compact graph accordingly. The ids of the compact edges
+     * do not change, so solutions given by compact edge ids remain valid.
+     * @param newIds Vector mapping every node of the current compact graph to its new id.
+     */
+    void relabel(const std::vector<Node>& newIds);
+
 public:
     Graph compactGraph;
     const Graph& originalGraph;
@@ -26,6 +47,9 @@ public:
     const size_t blueArcs;
     std::vector<bool> edgeProcessed;
     std::map<EdgeId, EdgeId> compactEdgeIds2OriginalEdgeIds;
+    std::map<EdgeId, std::vector<EdgeId>> equivalentEdgeIds; ///< Equal-cost parallel alternatives, by original id.
+    size_t parallelArcs{0}; ///< Parallel edges between components that were not copied into the compact graph.
+    size_t contractedArcs{0}; ///< Compact edges merged into the components after the initial contraction.
 
 private:
     void generateNodes2ComponentsLinks();
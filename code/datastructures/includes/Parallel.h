@@ -0,0 +1,55 @@
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+inline size_t hardwareThreads() {
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/**
+ * Number of threads used to process count independent tasks: at most one per hardware thread and at least
+ * minTasksPerThread tasks per thread, so that cheap tasks do not pay for starting threads.
+ */
+inline size_t threadsFor(size_t count, size_t minTasksPerThread = 1) {
+    return std::min((count + minTasksPerThread - 1) / minTasksPerThread, hardwareThreads());
+}
+
+/**
+ * Calls f(thread, i) for every i from 0 to count - 1, distributing the calls among threadsFor(count, minTasksPerThread)
+ * threads. The calling thread takes part in the work. thread is the index of the executing thread, so f can use
+ * per-thread data.
+ */
+template <typename F>
+void inParallelPerThread(size_t count, F f, size_t minTasksPerThread = 1) {
+    std::atomic<size_t> next{0};
+    auto work = [count, &f, &next](size_t thread) {
+        for (size_t i = next++; i < count; i = next++) {
+            f(thread, i);
+        }
+    };
+    size_t threadsCount = threadsFor(count, minTasksPerThread);
+    std::vector<std::thread> threads;
+    for (size_t thread = 1; thread < threadsCount; ++thread) {
+        threads.emplace_back(work, thread);
+    }
+    work(0);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+/**
+ * Calls f(i) for every i from 0 to count - 1, distributing the calls among the available threads.
+ */
+template <typename F>
+void inParallel(size_t count, F f, size_t minTasksPerThread = 1) {
+    inParallelPerThread(count, [&f](size_t, size_t i) {
+        f(i);
+    }, minTasksPerThread);
+}
+
+#endif
@@ -137,6 +137,12 @@ class Graph {
         std::vector<NodeAdjacency> nodes;
 };
 
+/**
+ * Copy of G in which the costs of every edge are reordered according to objectiveOrder: objective i of the copy is
+ * objective objectiveOrder[i] of G. Edge ids and the order of the adjacency lists are preserved.
+ */
+Graph permuteCosts(const Graph& G, const DimensionsVector& objectiveOrder);
+
 template<class Comparator>
 static void sortArcs(Graph& G, const Comparator& comp) {
     for (size_t i = 0; i < G.nodesCount; ++i) {
@@ -8,7 +8,9 @@
 //
 // Created by pedro on 10.08.21.
 //
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef> //For size_t.
 #include <limits>
 #include <list>
@@ -203,6 +205,46 @@ inline bool truncatedDominance(const TruncatedFront& front, const CostArray& c)
     return false;
 }
 
+/**
+ * Rounding used by the approximation mode. In every dimension but the first one, costs are mapped to their position
+ * on the grid of powers of (1+delta). Two costs whose positions are ordered differ by at most a factor of (1+delta).
+ * Since positions are compared exactly, dominance among rounded costs stays transitive. The first dimension decides
+ * the lexicographic extraction order and is never rounded.
+ */
+struct CostRounding {
+    CostRounding() = default;
+
+    /**
+     * @param epsilon Approximation guarantee per dimension. Entry 0 is ignored, entries equal to 0 mean exact.
+     * @param edgesPerTree Number of times a subtree can be replaced by a rounded dominating one on its way to
+     * the target. delta is chosen such that (1+delta)^edgesPerTree = 1+epsilon.
+     */
+    CostRounding(const Info<double>& epsilon, size_t edgesPerTree) {
+        for (Dimension i = 1; i < DIM; ++i) {
+            if (epsilon[i] > 0) {
+                this->exact = false;
+                this->logBase[i] = std::log1p(epsilon[i]) / std::max<size_t>(edgesPerTree, 1);
+            }
+        }
+    }
+
+    inline CostArray round(const CostArray& c) const {
+        if (this->exact) {
+            return c;
+        }
+        CostArray rounded = c;
+        for (Dimension i = 1; i < DIM; ++i) {
+            if (this->logBase[i] > 0 && c[i] > 0) {
+                rounded[i] = 1 + static_cast<CostType>(std::floor(std::log(c[i]) / this->logBase[i]));
+            }
+        }
+        return rounded;
+    }
+
+    Info<double> logBase{}; ///< log(1+delta) per dimension, 0 for exact dimensions.
+    bool exact{true};
+};
+
 inline const CostArray substract(const CostArray& rhs, const CostArray& lhs) {
     CostArray res;
     for (size_t i = 0; i < DIM; ++i) {
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include "../includes/GraphCompacter.h"
 
 static CostArray computeCosts(const ConnectedComponents& connectedComponents) {
@@ -37,25 +39,82 @@ void GraphCompacter::generateNodes2ComponentsLinks() {
 }
 
 void GraphCompacter::buildCompactGraph() {
+    this->compactGraph = Graph();
+    //The alternatives of the edges contracted into the components remain valid, the others are recomputed below.
+    for (const auto& ids : this->compactEdgeIds2OriginalEdgeIds) {
+        const Edge& edge = this->originalGraph.edges[ids.second];
+        if (this->node2connectedComponent[edge.tail] != this->node2connectedComponent[edge.head]) {
+            this->equivalentEdgeIds.erase(ids.second);
+        }
+    }
+    this->compactEdgeIds2OriginalEdgeIds.clear();
+    this->parallelArcs = 0;
     //Create one node per connected component.
     for (size_t componentId = 0; componentId < this->connectedComponents->size(); ++componentId) {
         this->compactGraph.addNode(componentId);
     }
-    //Now, we iterate over all edges in the original graph. Every edge that connects two distinct
-    //connected components is added to the compact graph. The new copy links the two connected components
-    //that contain the original nodes connected by the original edge.
-    EdgeId addedEdges{0};
+    //Every edge that connects two distinct connected components is a candidate for the compact graph. Candidates
+    //linking the same pair of components are parallel in the compact graph, so we group them first.
+    std::map<std::pair<Node, Node>, std::vector<EdgeId>> parallelEdges;
     for (const Edge& edge: this->originalGraph.edges) {
         if (edge.isRed) {
             continue;
         }
-        Node tail = edge.tail;
-        Node head = edge.head;
-        Node tailInNewGraph = node2connectedComponent[tail];
-        Node headInNewGraph = node2connectedComponent[head];
+        Node tailInNewGraph = node2connectedComponent[edge.tail];
+        Node headInNewGraph = node2connectedComponent[edge.head];
         if (tailInNewGraph == headInNewGraph) {
             continue;
         }
+        parallelEdges[std::minmax(tailInNewGraph, headInNewGraph)].push_back(edge.id);
+    }
+    //A parallel edge that is dominated by a sibling can be exchanged by it in every spanning tree without
+    //worsening its costs. We first drop the strictly dominated edges. Among the equal-cost survivors, we only keep
+    //the first one and record the others as its alternatives. Equal-cost siblings are either all strictly
+    //dominated or all survive, so an alternative always points to a kept edge.
+    std::vector<EdgeId> representative(this->originalGraph.edges.size(), INVALID_ARC);
+    std::vector<EdgeId> survivors;
+    for (const auto& bundle : parallelEdges) {
+        const std::vector<EdgeId>& siblings{bundle.second};
+        survivors.clear();
+        for (size_t i = 0; i < siblings.size(); ++i) {
+            const CostArray& c = this->originalGraph.edges[siblings[i]].c;
+            bool dominated = false;
+            for (size_t j = 0; j < siblings.size() && !dominated; ++j) {
+                const CostArray& cSibling = this->originalGraph.edges[siblings[j]].c;
+                dominated = j != i && cSibling != c && dominates(cSibling, c);
+            }
+            if (dominated) {
+                ++this->parallelArcs;
+            }
+            else {
+                survivors.push_back(siblings[i]);
+            }
+        }
+        for (size_t i = 0; i < survivors.size(); ++i) {
+            representative[survivors[i]] = survivors[i];
+            for (size_t j = 0; j < i; ++j) {
+                if (representative[survivors[j]] == survivors[j] &&
+                    this->originalGraph.edges[survivors[j]].c == this->originalGraph.edges[survivors[i]].c) {
+                    representative[survivors[i]] = survivors[j];
+                    ++this->parallelArcs;
+                    break;
+                }
+            }
+        }
+    }
+    //Now, we add the surviving edges in the order of the original graph. The new copy links the two connected
+    //components that contain the original nodes connected by the original edge.
+    EdgeId addedEdges{0};
+    for (const Edge& edge: this->originalGraph.edges) {
+        EdgeId kept = representative[edge.id];
+        if (kept != edge.id) {
+            if (kept != INVALID_ARC) {
+                this->equivalentEdgeIds[kept].push_back(edge.id);
+            }
+            continue;
+        }
+        Node tailInNewGraph = node2connectedComponent[edge.tail];
+        Node headInNewGraph = node2connectedComponent[edge.head];
         this->compactGraph.edges.emplace_back(addedEdges, tailInNewGraph, headInNewGraph, edge.c);
         this->compactEdgeIds2OriginalEdgeIds.emplace(addedEdges, edge.id);
         ++addedEdges;
@@ -71,6 +130,63 @@ EdgeId GraphCompacter::getOriginalId(const Edge &edgeinCompactGraph) const {
     return this->compactEdgeIds2OriginalEdgeIds.at(edgeinCompactGraph.id);
 }
 
+const std::vector<EdgeId>& GraphCompacter::getEquivalentOriginalIds(EdgeId originalEdgeId) const {
+    static const std::vector<EdgeId> noEquivalents;
+    auto it = this->equivalentEdgeIds.find(originalEdgeId);
+    return it != this->equivalentEdgeIds.end() ? it->second : noEquivalents;
+}
+
+void GraphCompacter::contract(const std::vector<EdgeId>& compactEdgeIds) {
+    //Every compact node is a component. Merged components are collected in the component with the smallest id.
+    std::vector<Node> mergedInto(this->connectedComponents->size());
+    std::iota(mergedInto.begin(), mergedInto.end(), 0);
+    auto find = [&mergedInto](Node n) {
+        while (mergedInto[n] != n) {
+            n = mergedInto[n];
+        }
+        return n;
+    };
+    for (EdgeId edgeId : compactEdgeIds) {
+        const Edge& edge = this->compactGraph.edges[edgeId];
+        Node tailComponent = find(edge.tail);
+        Node headComponent = find(edge.head);
+        assert(tailComponent != headComponent);
+        if (headComponent < tailComponent) {
+            std::swap(tailComponent, headComponent);
+        }
+        mergedInto[headComponent] = tailComponent;
+        ConnectedComponent& target = (*this->connectedComponents)[tailComponent];
+        ConnectedComponent& source = (*this->connectedComponents)[headComponent];
+        target.component.insert(source.component.begin(), source.component.end());
+        target.edgeIds.insert(source.edgeIds.begin(), source.edgeIds.end());
+        target.edgeIds.insert(this->getOriginalId(edge));
+        addInPlace(target.cost, source.cost);
+        addInPlace(target.cost, edge.c);
+        addInPlace(this->connectedComponentsCost, edge.c);
+        ++this->contractedArcs;
+    }
+    std::unique_ptr<ConnectedComponents> remaining = std::make_unique<ConnectedComponents>();
+    for (Node componentId = 0; componentId < this->connectedComponents->size(); ++componentId) {
+        if (mergedInto[componentId] == componentId) {
+            remaining->push_back(std::move((*this->connectedComponents)[componentId]));
+        }
+    }
+    this->connectedComponents = std::move(remaining);
+    this->generateNodes2ComponentsLinks();
+    this->buildCompactGraph();
+}
+
+void GraphCompacter::relabel(const std::vector<Node>& newIds) {
+    assert(newIds.size() == this->connectedComponents->size());
+    std::unique_ptr<ConnectedComponents> relabeled = std::make_unique<ConnectedComponents>(newIds.size());
+    for (Node componentId = 0; componentId < newIds.size(); ++componentId) {
+        (*relabeled)[newIds[componentId]] = std::move((*this->connectedComponents)[componentId]);
+    }
+    this->connectedComponents = std::move(relabeled);
+    this->generateNodes2ComponentsLinks();
+    this->buildCompactGraph();
+}
+
 //CostArray GraphCompacter::getBlueComponentsCosts() const {
 //    for (const std::set<>)
 //}
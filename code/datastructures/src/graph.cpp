@@ -135,4 +135,17 @@ NodeAdjacency::NodeAdjacency(const Node nid, NeighborhoodSize degree):
         adjacentArcs(degree),
         id{nid} {
     adjacentArcs.shrink_to_fit();
-}
\ No newline at end of file
+}
+
+Graph permuteCosts(const Graph& G, const DimensionsVector& objectiveOrder) {
+    Graph permuted = G;
+    for (Edge& edge : permuted.edges) {
+        edge.c = sorted(edge.c, objectiveOrder);
+    }
+    for (Node n = 0; n < permuted.nodesCount; ++n) {
+        for (Arc& arc : permuted.adjacentArcs(n)) {
+            arc.c = sorted(arc.c, objectiveOrder);
+        }
+    }
+    return permuted;
+}
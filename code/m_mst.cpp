@@ -1,7 +1,23 @@
 #define BN_ALGO
 #define IG_MDA
+//Two-phase method: weighted sum MSTs followed by a ranking of the spanning trees (see TwoPhaseSearch).
+//#define TWO_PHASE
+//Rank the spanning trees of the contracted graph by the weighted sum RANKING_WEIGHTS and return the K_BEST cheapest.
+//#define K_BEST_TREES
+//Branch-and-bound on the edges of the contracted graph, for graphs that are too large for IG-MDA and BN.
+//#define BRANCH_AND_BOUND
+//Solve the biconnected blocks of the contracted graph independently and combine their fronts.
+#define BLOCK_DECOMPOSITION
 
 //#define PRINT_ALL_TREES
+//Print every efficient tree as soon as the search finds it.
+//#define STREAM_TREES
+//Choose the objective order of IG-MDA and BN automatically instead of using OBJECTIVE_ORDER.
+//#define AUTOMATIC_OBJECTIVE_ORDER
+//Run IG-MDA and BN with every candidate objective order, report their running times and use the fastest order.
+//#define BENCHMARK_OBJECTIVE_ORDERS
+//Only compute the costs of the efficient trees. PRINT_ALL_TREES then prints the costs without the edges.
+//#define COSTS_ONLY
 
 #include <chrono>
 #include <ctime>
@@ -13,14 +29,191 @@
 #include "preprocessing/includes/Preprocessor.h"
 #include "search/includes/MultiPrim.h"
 #include "search/includes/BN.h"
+#include "search/includes/TwoPhase.h"
+#include "search/includes/Ranking.h"
+#include "search/includes/BranchAndBound.h"
+#include "search/includes/BlockDecomposition.h"
 
 #include "search/includes/Solution.h"
+#include "search/includes/Anytime.h"
+#include "search/includes/ObjectiveOrder.h"
+
+//Stop the searches after DEADLINE seconds or after MAX_SOLUTIONS efficient trees. Zero means no limit.
+constexpr double DEADLINE{0};
+constexpr size_t MAX_SOLUTIONS{0};
+//Only compute the efficient trees whose costs do not exceed BUDGET in any objective, e.g., {MAX_COST, 5000, 5000}.
+const CostArray BUDGET{generate(MAX_COST)};
+//Priority of the objectives in the lexicographic order in which the searches find the efficient trees, e.g., {2, 0, 1}
+//compares the third objective first. Together with MAX_SOLUTIONS, this yields the best trees for one objective.
+const DimensionsVector OBJECTIVE_ORDER{standardSorting()};
+//Time in seconds for which every candidate order runs when the objective order is chosen automatically.
+constexpr double ORDER_SAMPLING_TIME{0.05};
+//Number of trees and weight vector of the ranking computed with K_BEST_TREES.
+constexpr size_t K_BEST{100};
+const Info<CostType> RANKING_WEIGHTS{generate(1)};
 
 //#include "valgrind/callgrind.h"
 #include <boost/asio/ip/host_name.hpp>
 
+#ifdef BENCHMARK_OBJECTIVE_ORDERS
+//Prints one line per benchmarked objective order and returns the fastest order.
+static DimensionsVector reportOrderBenchmark(const char* algorithm, const std::string& graphName,
+                                             const std::vector<OrderBenchmark>& results, FILE* logCollectionFile) {
+    const OrderBenchmark* fastest{&results.front()};
+    for (const OrderBenchmark& result : results) {
+        std::string order;
+        for (Dimension i = 0; i < DIM; ++i) {
+            order += (i == 0 ? "" : "-") + std::to_string(result.order[i]);
+        }
+        char orderBuffer[200];
+        snprintf(orderBuffer, 200, "ORDER;%s;%uDIM;%s;%s;%lf;%lu;%lu\n", algorithm, DIM, graphName.c_str(),
+                 order.c_str(), result.time, result.trees, result.extractions);
+        std::cout << orderBuffer;
+        fprintf(logCollectionFile, "%s", orderBuffer);
+        if (result.time < fastest->time) {
+            fastest = &result;
+        }
+    }
+    return fastest->order;
+}
+#endif
+
+//Data of the input instance that every engine needs.
+struct Instance {
+    const char* path;
+    std::string graphName;
+    std::string hostName;
+    Info<double> epsilon;
+    FILE* logCollectionFile;
+};
+
+//Instance read and preprocessed with the settings from the top of this file.
+struct PreprocessedInstance {
+    std::unique_ptr<Graph> G;
+    Preprocessor preprocessor;
+    GraphCompacter contractedGraph;
+};
+
+template <typename Sorter>
+static PreprocessedInstance preprocess(const Instance& instance, const Sorter& sorter) {
+    std::unique_ptr<Graph> G = setupGraph(instance.path, sorter);
+    Preprocessor preprocessor;
+    preprocessor.epsilon = instance.epsilon;
+    preprocessor.budget = BUDGET;
+#ifdef COSTS_ONLY
+    preprocessor.costsOnly = true;
+#endif
+    GraphCompacter contractedGraph = preprocessor.run(*G);
+    return {std::move(G), std::move(preprocessor), std::move(contractedGraph)};
+}
+
+/**
+ * Prints the trees of the solution if PRINT_ALL_TREES is set, then prints the results line of an engine and appends
+ * it to the log file. The line contains the instance, the preprocessing and running times, the engine specific
+ * counters, the host and the current time.
+ */
+static void reportResults(const char* algorithm, const Instance& instance, const PreprocessedInstance& preprocessed,
+                          Solution& solution, double cpuTime, const char* counters) {
+    std::time_t end_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+#ifdef PRINT_ALL_TREES
+    solution.printSpanningTrees(preprocessed.contractedGraph);
+#endif
+    char resultsBuffer[350];
+    snprintf(resultsBuffer, 350, "%s;%uDIM;%s;%d;%d;%lu;%lu;%lf;%lf;%lf;%s;%s;%s\n",
+            algorithm, DIM, instance.graphName.c_str(), preprocessed.G->nodesCount, preprocessed.G->arcsCount,
+            preprocessed.contractedGraph.blueArcs, preprocessed.contractedGraph.redArcs,
+            preprocessed.preprocessor.duration, solution.time, cpuTime, counters,
+            instance.hostName.c_str(), std::ctime(&end_time));
+    std::cout << resultsBuffer << std::endl;
+    fprintf(instance.logCollectionFile, "%s", resultsBuffer);
+}
+
+//Engine specific preparation of the contracted graph, e.g., BN expects the adjacency lists in its own order.
+template <typename Search>
+struct ContractedGraphPreparation {
+    static void apply(Graph&) {}
+};
+
+template <>
+struct ContractedGraphPreparation<BN::MultiobjectiveSearch> {
+    static void apply(Graph& compactGraph) {
+        BN::ArcSorter arcSorter;
+        sortArcs(compactGraph, arcSorter);
+    }
+};
+
+//Search that runEngine executes for an engine. The objective orders are sampled and benchmarked with it as well.
+#ifdef BLOCK_DECOMPOSITION
+template <typename Search>
+using EngineSearch = BlockSearch<Search>;
+#else
+template <typename Search>
+using EngineSearch = Search;
+#endif
+
+/**
+ * Reads the instance, preprocesses it, runs Search on the contracted graph with the settings from the top of this file
+ * and reports the results. The objective order is only chosen automatically or benchmarked for the searches with a
+ * lexicographicOrder: the other searches compute the whole front anyway, the order only changes how it is sorted.
+ */
+template <typename Search, typename Sorter>
+static void runEngine(const char* algorithm, const Instance& instance, const Sorter& sorter) {
+    PreprocessedInstance preprocessed = preprocess(instance, sorter);
+    Preprocessor& preprocessor = preprocessed.preprocessor;
+    GraphCompacter& contractedGraph = preprocessed.contractedGraph;
+    ContractedGraphPreparation<Search>::apply(contractedGraph.compactGraph);
+    DimensionsVector objectiveOrder{OBJECTIVE_ORDER};
+#ifdef AUTOMATIC_OBJECTIVE_ORDER
+    if (Search::lexicographicOrder) {
+        auto orderStart = std::chrono::high_resolution_clock::now();
+        objectiveOrder = selectObjectiveOrder<EngineSearch<Search>>(contractedGraph.compactGraph, preprocessor,
+                                                                    ORDER_SAMPLING_TIME);
+        std::chrono::duration<double> orderDuration = std::chrono::high_resolution_clock::now() - orderStart;
+        preprocessor.duration += orderDuration.count();
+    }
+#elif defined(BENCHMARK_OBJECTIVE_ORDERS)
+    if (Search::lexicographicOrder) {
+        objectiveOrder = reportOrderBenchmark(
+                algorithm, instance.graphName,
+                benchmarkObjectiveOrders<EngineSearch<Search>>(contractedGraph.compactGraph, preprocessor,
+                                                               rankObjectiveOrders(contractedGraph.compactGraph)),
+                instance.logCollectionFile);
+    }
+#endif
+    ObjectiveOrderSearch<EngineSearch<Search>> search(contractedGraph.compactGraph, preprocessor, objectiveOrder);
+    AnytimeSettings anytime;
+    anytime.deadline = DEADLINE;
+    anytime.maxSolutions = MAX_SOLUTIONS;
+#ifdef STREAM_TREES
+    anytime.sink = [&contractedGraph](const CostArray&, const std::vector<EdgeId>& edgeIds) {
+        Solution::printSpanningTree(contractedGraph, edgeIds);
+    };
+#endif
+    //The bounds recomputed for a non-standard objective order are preprocessing, not search time.
+    preprocessor.duration += search.boundsDuration();
+    search.setAnytime(anytime);
+    std::clock_t c_start = std::clock();
+    Solution solution = search.run();
+    std::clock_t c_end = std::clock();
+    char counters[200];
+    snprintf(counters, 200, "%lu;%lu;%lu;%lu;%lu;%lu;%lu;%d;%lu",
+            solution.trees, solution.extractions, solution.insertions, solution.nqtIt, solution.transitionNodes,
+            solution.transitionArcs, solution.prunedTrees, solution.complete, contractedGraph.parallelArcs);
+    reportResults(algorithm, instance, preprocessed, solution, (1000 * (c_end - c_start) / CLOCKS_PER_SEC) / 1000.,
+                  counters);
+}
+
 int main(int argc, char *argv[]) {
-    (void) argc;
+    //Optional arguments after the instance path: approximation factors epsilon for the objectives 2,...,DIM. The
+    //first objective is always solved exactly.
+    Info<double> epsilon{};
+    for (Dimension i = 1; i < DIM && static_cast<int>(i) + 1 < argc; ++i) {
+        epsilon[i] = std::stod(argv[i + 1]);
+        if (epsilon[i] < 0) {
+            printf("Approximation factors must be non-negative.\n");
+            exit(1);
+        }
+    }
 
     const auto host_name = boost::asio::ip::host_name();
 
@@ -37,62 +230,36 @@ int main(int argc, char *argv[]) {
     FILE* logCollectionFile;
     logCollectionFile = fopen("logs.txt", "a");
 
+    const Instance instance{argv[1], graphName, host_name, epsilon, logCollectionFile};
+
 #ifdef IG_MDA
+    runEngine<IGMDA>("IG-MDA", instance, EdgeSorter{standardSorting()});
+#endif
+
+#ifdef TWO_PHASE
+    runEngine<TwoPhaseSearch>("TwoPhase", instance, EdgeSorter{standardSorting()});
+#endif
+
+#ifdef BRANCH_AND_BOUND
+    runEngine<BranchAndBoundSearch>("BranchAndBound", instance, EdgeSorter{standardSorting()});
+#endif
+
+#ifdef K_BEST_TREES
     {
-        EdgeSorter edgeComparator{standardSorting()};
-        std::unique_ptr<Graph> G_ptr = setupGraph(argv[1], edgeComparator);
-        Graph& G = *G_ptr;
-        Preprocessor preprocessor;
-        GraphCompacter contractedGraph = preprocessor.run(G);
-        IGMDA biSearch(contractedGraph.compactGraph);
+        PreprocessedInstance preprocessed = preprocess(instance, EdgeSorter{standardSorting()});
+        SpanningTreeRanking ranking(preprocessed.contractedGraph.compactGraph, RANKING_WEIGHTS);
         std::clock_t c_start = std::clock();
-        Solution solution = biSearch.run();
+        Solution solution = ranking.kBest(K_BEST);
         std::clock_t c_end = std::clock();
-        std::time_t end_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-#ifdef PRINT_ALL_TREES
-        solution.printSpanningTrees(contractedGraph);
-#endif
-        char resultsBuffer[350];
-        snprintf(resultsBuffer, 350, "IG-MDA;%uDIM;%s;%d;%d;%lu;%lu;%lf;%lf;%lf;%lu;%lu;%lu;%lu;%lu;%lu;%s;%s\n",
-                DIM, graphName.c_str(), G.nodesCount, G.arcsCount,
-                contractedGraph.blueArcs, contractedGraph.redArcs,
-                preprocessor.duration, solution.time, (1000 * (c_end - c_start) / CLOCKS_PER_SEC) / 1000.,
-                solution.trees, solution.extractions, solution.insertions, solution.nqtIt, solution.transitionNodes,
-                solution.transitionArcs,
-                host_name.c_str(), std::ctime(&end_time));
-        std::cout << resultsBuffer << std::endl;
-        fprintf(logCollectionFile, "%s", resultsBuffer);
-    };
+        char counters[100];
+        snprintf(counters, 100, "%lu;%lu;%lu;%lu", K_BEST, solution.trees, solution.extractions, solution.insertions);
+        reportResults("KBest", instance, preprocessed, solution, (1000 * (c_end - c_start) / CLOCKS_PER_SEC) / 1000.,
+                      counters);
+    }
 #endif
 
-
 #ifdef BN_ALGO
-    EdgeSorterBN sorter;
-    std::unique_ptr<Graph> G_ptr = setupGraph(argv[1], sorter);
-    Graph& G = *G_ptr;
-    Preprocessor preprocessor;
-    GraphCompacter contractedGraph = preprocessor.run(G);
-    BN::ArcSorter arcSorter;
-    sortArcs(contractedGraph.compactGraph, arcSorter);
-
-    BN::MultiobjectiveSearch bnSearch(contractedGraph.compactGraph);
-    std::clock_t c_start_bn = std::clock();
-    Solution bnSolution = bnSearch.run();
-    std::clock_t c_end_bn = std::clock();
-#ifdef PRINT_ALL_TREES
-    bnSolution.printSpanningTrees(contractedGraph);
-#endif
-    //bnSearch.printParetoFront(*contractedGraph.connectedComponents);
-
-    char bnResultsBuffer [350];
-    std::time_t bn_end_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    snprintf(bnResultsBuffer, 350, "MultiBN;%uDIM;%s;%d;%d;%lu;%lu;%lf;%lf;%lf;%lu;%lu;%lu;%lu;%lu;%lu;%s;%s",
-            DIM, graphName.c_str(), G.nodesCount, G.arcsCount, contractedGraph.blueArcs, contractedGraph.redArcs,
-            preprocessor.duration, bnSolution.time, (1000* (c_end_bn - c_start_bn) / CLOCKS_PER_SEC)/1000.,
-            bnSolution.trees, bnSolution.extractions, bnSolution.insertions, bnSolution.nqtIt, bnSolution.transitionNodes, bnSolution.transitionArcs, host_name.c_str(),
-            std::ctime(&bn_end_time));
-    std::cout << bnResultsBuffer << std::endl;
-    fprintf(logCollectionFile, "%s", bnResultsBuffer);
+    runEngine<BN::MultiobjectiveSearch>("MultiBN", instance, EdgeSorterBN());
 #endif
 
 
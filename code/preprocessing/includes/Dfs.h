@@ -7,18 +7,21 @@
 
 #include <vector>
 #include "../../datastructures/includes/typedefs.h"
+#include "EdgeDominance.h"
 
 class Graph;
 struct Arc;
 
 class DFS {
 public:
-    DFS(Graph& G, Node source, Arc& a);
+    DFS(Graph& G, Node source, Arc& a, const EdgeDominance& dominance);
 
     void runRed();
     void runBlue();
 
 private:
+    inline bool dominates(const Arc& lhs, const Arc& rhs) const;
+
     void searchRed(const Node startNode);
 
     void searchBlue(const Node startNode);
@@ -26,11 +29,12 @@ private:
     Graph& G;
     const Node source;
     Arc& relevantArc;
+    const EdgeDominance& dominance;
     std::vector<bool> visited;
 };
 
-size_t findRedArcs(Graph& G);
+size_t findRedArcs(Graph& G, const EdgeDominance& dominance);
 
-size_t findBlueArcs(Graph& G);
+size_t findBlueArcs(Graph& G, const EdgeDominance& dominance);
 
 #endif //BI_MST_DFS_H
@@ -0,0 +1,81 @@
+#ifndef BI_MST_EDGE_DOMINANCE_H
+#define BI_MST_EDGE_DOMINANCE_H
+
+#include <cstdint>
+#include <vector>
+#include "../../datastructures/includes/typedefs.h"
+
+class Graph;
+
+//Graphs with more edges are not indexed since the relation needs (number of edges)^2 bits.
+constexpr EdgeId MAX_INDEXED_EDGES = 8192;
+
+/**
+ * Dominance relation between the edges of a graph, computed once and stored as one bitset per edge: bit f of the
+ * row of edge e is set if the costs of f dominate the costs of e (equal costs included, e itself excluded). Sets of
+ * edges are bitsets of the same width, so checking whether an edge is dominated by an edge of a set is a word-wise
+ * AND over two rows. The relation is not computed for graphs with more than MAX_INDEXED_EDGES edges, callers
+ * have to compare the edge costs themselves if indexed() is false.
+ */
+class EdgeDominance {
+public:
+    typedef uint64_t Block;
+    typedef std::vector<Block> EdgeSet;
+
+    EdgeDominance() = default;
+
+    /**
+     * Computes the relation for the edges of G in parallel. Also stores the set of incident edges of every node.
+     */
+    explicit EdgeDominance(const Graph& G);
+
+    inline bool indexed() const {
+        return this->blocksPerRow > 0;
+    }
+
+    inline EdgeSet emptySet() const {
+        return EdgeSet(this->blocksPerRow, 0);
+    }
+
+    static inline void insert(EdgeSet& edges, EdgeId e) {
+        edges[e / 64] |= Block{1} << (e % 64);
+    }
+
+    inline bool dominates(EdgeId dominating, EdgeId dominated) const {
+        return (this->dominators[dominated * this->blocksPerRow + dominating / 64] >> (dominating % 64)) & 1;
+    }
+
+    /**
+     * True if an edge in edges dominates e.
+     */
+    inline bool dominatedBySome(EdgeId e, const EdgeSet& edges) const {
+        const Block* row = &this->dominators[e * this->blocksPerRow];
+        for (size_t i = 0; i < this->blocksPerRow; ++i) {
+            if (row[i] & edges[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * True if an edge in edges that is incident to n dominates e.
+     */
+    inline bool dominatedBySomeIncidentTo(EdgeId e, const EdgeSet& edges, Node n) const {
+        const Block* row = &this->dominators[e * this->blocksPerRow];
+        const Block* incident = &this->incidence[n * this->blocksPerRow];
+        for (size_t i = 0; i < this->blocksPerRow; ++i) {
+            if (row[i] & edges[i] & incident[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    size_t blocksPerRow{0};
+    std::vector<Block> dominators;
+    std::vector<Block> incidence;
+};
+
+#endif //BI_MST_EDGE_DOMINANCE_H
@@ -0,0 +1,25 @@
+#ifndef BI_MST_NODE_ORDERING_H
+#define BI_MST_NODE_ORDERING_H
+
+#include <vector>
+#include "../../datastructures/includes/typedefs.h"
+
+class Graph;
+
+/**
+ * Finds a pseudo-peripheral node of G (George and Liu): starting at a node of minimum degree, repeatedly jump to a
+ * node of minimum degree in the last level of a breadth first search until the number of levels stops growing.
+ */
+Node pseudoPeripheralNode(const Graph& G);
+
+/**
+ * New ids for the nodes of G that are used as indices of the transition space. The searches start at node 0, and
+ * the transition nodes are the connected node subsets containing it. Rooting the search at a peripheral node keeps
+ * their number small (think of a path). The remaining nodes are numbered in Cuthill-McKee order from the root,
+ * i.e., breadth first with neighbors of small degree first. Early subsets then only use the low bits of their
+ * indices, which improves the locality of the transition nodes in memory, and the cuts of the subsets stay short.
+ * @return Vector mapping every node of G to its new id.
+ */
+std::vector<Node> transitionSpaceOrder(const Graph& G);
+
+#endif //BI_MST_NODE_ORDERING_H
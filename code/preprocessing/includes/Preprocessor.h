@@ -9,6 +9,7 @@
 #include "boost/dynamic_bitset.hpp"
 
 #include "../../datastructures/includes/typedefs.h"
+#include "EdgeDominance.h"
 
 class Graph;
 class GraphCompacter;
@@ -33,13 +34,64 @@ struct LexComparison {
     }
 };
 
+struct WeightedLabel {
+
+    inline void update(uint64_t kNew, const CostArray& cNew, Node n) {
+        this->key = kNew;
+        this->c = cNew;
+        this->n = n;
+    }
+
+    uint32_t priority{std::numeric_limits<uint32_t>::max()}; ///< for heap operations.
+    uint64_t key{std::numeric_limits<uint64_t>::max()}; ///< weighted sum of c.
+    CostArray c{generate(MAX_COST)};
+    Node n = INVALID_NODE;
+    bool inQueue = false;
+};
+
+//Ties in the weighted sum are broken lexicographically, so zero weights still yield efficient trees.
+struct WeightedSumComparison {
+    inline bool operator() (const WeightedLabel* lhs, const WeightedLabel* rhs) const {
+        return lhs->key < rhs->key || (lhs->key == rhs->key && lexSmaller(lhs->c, rhs->c));
+    }
+};
+
+//Weight vectors for the warm start are all integer vectors whose entries add up to this value.
+constexpr CostType WEIGHTS_RESOLUTION = DIM == 2 ? 64 : DIM == 3 ? 16 : 8;
+
+//All integer weight vectors whose entries add up to resolution, i.e., a regular grid on the simplex.
+std::vector<Info<CostType>> weightedSumWeights(CostType resolution = WEIGHTS_RESOLUTION);
+
 class Preprocessor {
 public:
     explicit Preprocessor();
 
     GraphCompacter run(Graph& G);
 
-    void calculateHeuristic(const Graph& G);
+    /**
+     * Computes the lower bounds and the upper bound set for the given (compact) graph.
+     */
+    void computeBounds(const Graph& G);
+
+    /**
+     * Ideal point of the costs needed to connect the nodes outside of containedNodes to a subtree spanning
+     * containedNodes. For every objective, it is the cost of a minimum spanning tree of the graph in which
+     * containedNodes are contracted into a single node. Requires a previous call to computeLowerBounds.
+     */
+    CostArray subsetLowerBound(const NodesSubset& containedNodes) const;
+
+    /**
+     * True if a supported spanning tree in upperBoundSet dominates c and has different costs. In this case, every
+     * tree whose costs are not smaller than c in any dimension is dominated.
+     */
+    inline bool upperBoundDominance(const CostArray& c) const;
+
+    /**
+     * True if a spanning tree of the searched graph with costs c can complete a spanning tree within the budget.
+     */
+    inline bool withinBudget(const CostArray& c) const {
+        return dominates(add(c, this->fixedCosts), this->budget);
+    }
 
     //Graph& graph;
     //Entries of these vector are indexed from 0 to number of nodes - 1. Entry k stands for spanning trees
@@ -48,11 +100,44 @@ public:
     std::vector<CostArray> lb;
     //Initializing to MAX_COST implies that it does not prune away any solution.
     CostArray dominanceBound{generate(0)};
+    //Non-dominated costs of supported spanning trees found by weighted sum MSTs, sorted lexicographically.
+    std::vector<CostArray> upperBoundSet;
+    CostArray idealPoint{generate(MAX_COST)};
+    CostArray nadirPoint{generate(0)};
+    //Approximation guarantee per objective (see CostRounding). All zeros lets the searches compute the exact front.
+    Info<double> epsilon{};
+    //Only spanning trees of the original graph whose costs do not exceed the budget (a reference point) are computed.
+    CostArray budget{generate(MAX_COST)};
+    //Costs that every spanning tree of the original graph has on top of the costs of the spanning tree of the
+    //searched graph it contains. Set by run() to the costs of the contracted edges.
+    CostArray fixedCosts{generate(0)};
+    //If set, the searches only return the costs of the efficient trees and do not store the subtrees needed to
+    //rebuild them.
+    bool costsOnly{false};
+    //Dominance relation between the edges of the graph passed to computeBounds.
+    EdgeDominance edgeDominance;
     double duration{0};
 private:
+    //Entry u*n+v contains, for every objective, the cheapest edge connecting nodes u and v (MAX_COST if none).
+    std::vector<CostArray> cheapestEdges;
+    Node nodesCount{0};
     static CostArray Prim(const Graph& G, Node root, const DimensionsVector& dimOrdering);
     static CostArray Prim(const Graph& G, boost::dynamic_bitset<> containedNodes, const DimensionsVector& dimOrdering);
+    static CostArray Prim(const Graph& G, Node root, const Info<CostType>& weights);
     void computeLowerBounds(const Graph& G);
+    void computeSupportedSolutions(const Graph& G);
 };
 
+bool Preprocessor::upperBoundDominance(const CostArray& c) const {
+    for (const CostArray& u : this->upperBoundSet) {
+        if (u[0] > c[0]) {
+            break;
+        }
+        if (dominates(u, c) && u != c) {
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif //BI_MST_PREPROCESSOR_H
@@ -0,0 +1,33 @@
+#ifndef BI_MST_REDUCER_H
+#define BI_MST_REDUCER_H
+
+#include <vector>
+#include "../../datastructures/includes/typedefs.h"
+
+class Graph;
+class GraphCompacter;
+
+/**
+ * Edges of the compact graph that are bridges. Every spanning tree contains them. Degree-1 nodes are covered by
+ * this rule since their single edge is a bridge.
+ */
+std::vector<EdgeId> findBridges(const Graph& G);
+
+/**
+ * Looks for a degree-2 node whose two incident edges lead to different neighbors and one of them dominates the
+ * other. Exchanging the dominated edge by the dominating one in a spanning tree yields a spanning tree that is
+ * at least as good, so the dominating edge can be fixed. If both edges are incomparable, no single edge can
+ * replace the chain without losing efficient trees and the node is left untouched.
+ * @return The dominating edge or INVALID_ARC if no such node exists.
+ */
+EdgeId findDominatingSeriesEdge(const Graph& G);
+
+/**
+ * Applies the reduction rules above to the compact graph until none of them fires anymore. Every forced edge is
+ * merged into the connected components, which keeps the reconstruction of the solutions in the original graph
+ * exact. Parallel edges that appear after a contraction are filtered again when the compact graph is rebuilt.
+ * @return Number of contracted compact edges.
+ */
+size_t reduce(GraphCompacter& gc);
+
+#endif //BI_MST_REDUCER_H
@@ -9,8 +9,16 @@
 
 using namespace std;
 
-DFS::DFS(Graph &G, Node source, Arc &a):
-    G{G}, source{source}, relevantArc{a}, visited(G.nodesCount, false) {}
+DFS::DFS(Graph &G, Node source, Arc &a, const EdgeDominance& dominance):
+    G{G}, source{source}, relevantArc{a}, dominance{dominance}, visited(G.nodesCount, false) {}
+
+bool DFS::dominates(const Arc& lhs, const Arc& rhs) const {
+    if (this->dominance.indexed()) {
+        return lhs.idInEdgesVector == rhs.idInEdgesVector ||
+               this->dominance.dominates(lhs.idInEdgesVector, rhs.idInEdgesVector);
+    }
+    return ::dominates(lhs.c, rhs.c);
+}
 
 void DFS::runRed() {
     this->searchRed(source);
@@ -31,7 +39,7 @@ void DFS::searchRed(const Node startNode) {
                 continue;
             }
 //            if (a.c[0] <= relevantArc.c[0] && a.c[1] <= relevantArc.c[1]) {
-            if (dominates(a.c, relevantArc.c)) {
+            if (this->dominates(a, relevantArc)) {
                 searchRed(a.n);
             }
         }
@@ -56,14 +64,14 @@ void DFS::searchBlue(const Node startNode) {
                 continue;
             }
 //            if (!(relevantArc.c[0] <= a.c[0] && relevantArc.c[1] <= a.c[1]) || a.blueArc) {
-            if (!dominates(relevantArc.c, a.c) || a.blueArc) {
+            if (!this->dominates(relevantArc, a) || a.blueArc) {
                 searchBlue(a.n);
             }
         }
     }
 }
 
-size_t findRedArcs(Graph& G) {
+size_t findRedArcs(Graph& G, const EdgeDominance& dominance) {
     size_t redArcs{0};
     vector<bool> processed(G.arcsCount, false);
     for (Node u = 0; u < G.nodesCount; u++) {
@@ -74,7 +82,7 @@ size_t findRedArcs(Graph& G) {
                 continue;
             }
             processed[a.idInEdgesVector] = true;
-            DFS dfs(G, u, a);
+            DFS dfs(G, u, a, dominance);
             dfs.runRed();
             if (a.redArc) {
                 ++redArcs;
@@ -96,7 +104,7 @@ size_t findRedArcs(Graph& G) {
     return redArcs;
 }
 
-size_t findBlueArcs(Graph& G) {
+size_t findBlueArcs(Graph& G, const EdgeDominance& dominance) {
     size_t blueArcs{0};
     vector<bool> processed(G.arcsCount, false);
     for (Node u = 0; u < G.nodesCount; u++) {
@@ -107,7 +115,7 @@ size_t findBlueArcs(Graph& G) {
                 continue;
             }
             processed[a.idInEdgesVector] = true;
-            DFS dfs(G, u, a);
+            DFS dfs(G, u, a, dominance);
             dfs.runBlue();
             if (a.blueArc) {
                 ++blueArcs;
@@ -0,0 +1,32 @@
+#include "../../datastructures/includes/graph.h"
+#include "../../datastructures/includes/Parallel.h"
+#include "../includes/EdgeDominance.h"
+
+using namespace std;
+
+constexpr size_t ROWS_PER_THREAD{256};
+
+EdgeDominance::EdgeDominance(const Graph& G) {
+    const size_t edgesCount = G.edges.size();
+    if (edgesCount == 0 || edgesCount > MAX_INDEXED_EDGES) {
+        return;
+    }
+    this->blocksPerRow = (edgesCount + 63) / 64;
+    this->dominators.assign(edgesCount * this->blocksPerRow, 0);
+    this->incidence.assign(G.nodesCount * this->blocksPerRow, 0);
+    for (size_t e = 0; e < edgesCount; ++e) {
+        this->incidence[G.edges[e].tail * this->blocksPerRow + e / 64] |= Block{1} << (e % 64);
+        this->incidence[G.edges[e].head * this->blocksPerRow + e / 64] |= Block{1} << (e % 64);
+    }
+    //Every row is written by a single thread. A row only takes edgesCount comparisons, so a thread fills at least
+    //ROWS_PER_THREAD of them.
+    inParallel(edgesCount, [this, &G, edgesCount](size_t e) {
+        Block* row = &this->dominators[e * this->blocksPerRow];
+        const CostArray& c = G.edges[e].c;
+        for (size_t f = 0; f < edgesCount; ++f) {
+            if (f != e && ::dominates(G.edges[f].c, c)) {
+                row[f / 64] |= Block{1} << (f % 64);
+            }
+        }
+    }, ROWS_PER_THREAD);
+}
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "../../datastructures/includes/graph.h"
+#include "../includes/NodeOrdering.h"
+
+using namespace std;
+
+namespace {
+    //Breadth first search from root. Neighbors are visited in ascending order of their degree.
+    vector<Node> cuthillMcKee(const Graph& G, Node root, vector<size_t>& level) {
+        vector<Node> order;
+        order.reserve(G.nodesCount);
+        level.assign(G.nodesCount, G.nodesCount);
+        level[root] = 0;
+        order.push_back(root);
+        vector<Node> neighbors;
+        for (size_t position = 0; position < order.size(); ++position) {
+            Node u = order[position];
+            neighbors.clear();
+            for (const Arc& a : G.adjacentArcs(u)) {
+                if (level[a.n] == G.nodesCount) {
+                    level[a.n] = level[u] + 1;
+                    neighbors.push_back(a.n);
+                }
+            }
+            stable_sort(neighbors.begin(), neighbors.end(), [&G](Node lhs, Node rhs) {
+                return G.adjacentArcs(lhs).size() < G.adjacentArcs(rhs).size();
+            });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+        return order;
+    }
+}
+
+Node pseudoPeripheralNode(const Graph& G) {
+    auto degree = [&G](Node n) { return G.adjacentArcs(n).size(); };
+    Node root{0};
+    for (Node n = 1; n < G.nodesCount; ++n) {
+        if (degree(n) < degree(root)) {
+            root = n;
+        }
+    }
+    vector<size_t> level;
+    vector<Node> order = cuthillMcKee(G, root, level);
+    while (true) {
+        size_t eccentricity = level[order.back()];
+        Node candidate = order.back();
+        for (Node n : order) {
+            if (level[n] == eccentricity && degree(n) < degree(candidate)) {
+                candidate = n;
+            }
+        }
+        vector<size_t> candidateLevel;
+        vector<Node> candidateOrder = cuthillMcKee(G, candidate, candidateLevel);
+        if (candidateLevel[candidateOrder.back()] <= eccentricity) {
+            return root;
+        }
+        root = candidate;
+        order = move(candidateOrder);
+        level = move(candidateLevel);
+    }
+}
+
+vector<Node> transitionSpaceOrder(const Graph& G) {
+    vector<size_t> level;
+    vector<Node> order = cuthillMcKee(G, pseudoPeripheralNode(G), level);
+    assert(order.size() == G.nodesCount);
+    vector<Node> newIds(G.nodesCount);
+    for (Node position = 0; position < order.size(); ++position) {
+        newIds[order[position]] = position;
+    }
+    return newIds;
+}
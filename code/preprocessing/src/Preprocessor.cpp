@@ -2,15 +2,19 @@
 // Created by bzfmaris on 03.05.22.
 //
 #include <algorithm>
+#include <cassert>
 #include <chrono>
 
 #include "../../datastructures/includes/graph.h"
 #include "../../datastructures/includes/Label.h"
 #include "../../datastructures/includes/BinaryHeap.h"
 #include "../../datastructures/includes/GraphCompacter.h"
+#include "../../datastructures/includes/Parallel.h"
 
 #include "../includes/Dfs.h"
 #include "../includes/Preprocessor.h"
+#include "../includes/NodeOrdering.h"
+#include "../includes/Reducer.h"
 
 Preprocessor::Preprocessor()
 //    lb((1<<(nodesCount-1))) {}
@@ -35,15 +39,22 @@ std::vector<ConnectedComponent> contract(const Graph& G) {
 
 GraphCompacter Preprocessor::run(Graph& G) {
     auto start = std::chrono::high_resolution_clock::now();
-    size_t blueArcs = findBlueArcs(G);
-    size_t redArcs = findRedArcs(G);
+    EdgeDominance originalDominance(G);
+    size_t blueArcs = findBlueArcs(G, originalDominance);
+    size_t redArcs = findRedArcs(G, originalDominance);
 
     std::unique_ptr<ConnectedComponents> connectedComponents =
             std::make_unique<ConnectedComponents>(contract(G));
     GraphCompacter gc(G, connectedComponents, redArcs, blueArcs);
+    //Fix the edges of the compact graph that are forced by structural reasons.
+    reduce(gc);
+    //Choose the root of the searches and the node indices of the transition space.
+    if (gc.compactGraph.nodesCount > 1) {
+        gc.relabel(transitionSpaceOrder(gc.compactGraph));
+    }
+    this->fixedCosts = gc.connectedComponentsCost;
     //Now, compute the lower bounds.
-    this->computeLowerBounds(gc.compactGraph);
-//    this->calculateHeuristic(gc.compactGraph);
+    this->computeBounds(gc.compactGraph);
     //Finally, compute a dominance bound.
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> t = end - start;
@@ -91,31 +102,6 @@ CostArray Preprocessor::Prim(const Graph& G, Node root, const DimensionsVector&
     return treeCosts;
 }
 
-void Preprocessor::calculateHeuristic(const Graph& G) {
-    size_t subsets = (1<<(G.nodesCount-1));
-    //std::vector<CostArray> lb(subsets);
-    for (size_t i = 0; i < subsets; ++ i) {
-        size_t fullGraphRepresentation = i*2;
-        boost::dynamic_bitset<> containedNodes(G.nodesCount, fullGraphRepresentation);
-        containedNodes[0] = true;
-        DimensionsVector dimOrdering = standardSorting();
-        //printf("Processing %lu\n", i);
-        //fill dimOrderings vector from 0 to dimOrdering.size()-1.
-        Info<bool> processedMainDimensions;
-        std::fill(processedMainDimensions.begin(), processedMainDimensions.end(), false);
-        do {
-            //Avoid multiple lex. searches with the same first optimization criterion.
-            if (!processedMainDimensions[dimOrdering[0]]) {
-                processedMainDimensions[dimOrdering[0]] = true;
-                CostArray lexResult = Prim(G, containedNodes, dimOrdering);
-                lb[i][dimOrdering[0]] = lexResult[0];
-                //printf("\tDimOrdering = (%u, %u, %u)\n", dimOrdering[0], dimOrdering[1], dimOrdering[2]);
-                //printf("\t\tLexSolution = (%u, %u, %u)\n", lexResult[0], lexResult[1], lexResult[2]);
-            }
-        } while (std::next_permutation(dimOrdering.begin(), dimOrdering.end()));
-    }
-}
-
 CostArray Preprocessor::Prim(const Graph& G, boost::dynamic_bitset<> containedNodes, const DimensionsVector& dimOrdering) {
 
     std::vector<Label> labels(G.nodesCount);
@@ -159,6 +145,98 @@ CostArray Preprocessor::Prim(const Graph& G, boost::dynamic_bitset<> containedNo
     return treeCosts;
 }
 
+CostArray Preprocessor::Prim(const Graph& G, Node root, const Info<CostType>& weights) {
+    auto weightedSum = [&weights](const CostArray& c) {
+        uint64_t sum{0};
+        for (Dimension i = 0; i < DIM; ++i) {
+            sum += static_cast<uint64_t>(weights[i]) * c[i];
+        }
+        return sum;
+    };
+    std::vector<WeightedLabel> labels(G.nodesCount);
+    std::vector<bool> nodeSet(G.nodesCount, false);
+    BinaryHeap<WeightedLabel, WeightedSumComparison> heap;
+    labels[root].update(0, generate(0), root);
+    heap.push(&labels[root]);
+
+    CostArray treeCosts;
+    initialize(treeCosts, 0);
+    while (heap.size() != 0) {
+        WeightedLabel* min = heap.pop();
+        nodeSet[min->n] = true;
+        addInPlace(treeCosts, min->c);
+        for (const Arc& a: G.adjacentArcs(min->n)) {
+            Node nodeCandidate = a.n;
+            if (!nodeSet[nodeCandidate]) {
+                WeightedLabel candidate;
+                candidate.update(weightedSum(a.c), a.c, nodeCandidate);
+                WeightedLabel& newNodeLabel{labels[nodeCandidate]};
+                if (WeightedSumComparison()(&candidate, &newNodeLabel)) {
+                    newNodeLabel.update(candidate.key, candidate.c, nodeCandidate);
+                    if (!newNodeLabel.inQueue) {
+                        heap.push(&newNodeLabel);
+                    }
+                    else {
+                        heap.decreaseKey(&newNodeLabel);
+                    }
+                }
+            }
+        }
+    }
+    return treeCosts;
+}
+
+static void generateWeights(Info<CostType>& weights, Dimension position, CostType remaining, std::vector<Info<CostType>>& result) {
+    if (position == DIM - 1) {
+        weights[position] = remaining;
+        result.push_back(weights);
+        return;
+    }
+    for (CostType w = 0; w <= remaining; ++w) {
+        weights[position] = w;
+        generateWeights(weights, position + 1, remaining - w, result);
+    }
+}
+
+std::vector<Info<CostType>> weightedSumWeights(CostType resolution) {
+    std::vector<Info<CostType>> weightVectors;
+    Info<CostType> weights;
+    generateWeights(weights, 0, resolution, weightVectors);
+    return weightVectors;
+}
+
+void Preprocessor::computeBounds(const Graph& G) {
+    this->edgeDominance = EdgeDominance(G);
+    this->computeLowerBounds(G);
+    this->computeSupportedSolutions(G);
+}
+
+void Preprocessor::computeSupportedSolutions(const Graph& G) {
+    //Every weighted sum MST is a feasible spanning tree. The weights form a regular grid on the simplex, the unit
+    //vectors included. The MSTs for different weights are independent and computed in parallel.
+    const std::vector<Info<CostType>> weightVectors{weightedSumWeights()};
+    std::vector<CostArray> supported(weightVectors.size());
+    inParallel(weightVectors.size(), [&G, &weightVectors, &supported](size_t i) {
+        supported[i] = Prim(G, 0, weightVectors[i]);
+    });
+    std::sort(supported.begin(), supported.end(), [](const CostArray& lhs, const CostArray& rhs) {
+        return lexSmaller(lhs, rhs);
+    });
+    TruncatedFront front;
+    this->upperBoundSet.clear();
+    for (const CostArray& c : supported) {
+        if (truncatedDominance(front, c)) {
+            continue;
+        }
+        truncatedInsertion(front, c);
+        this->upperBoundSet.push_back(c);
+        for (Dimension i = 0; i < DIM; ++i) {
+            this->idealPoint[i] = std::min(this->idealPoint[i], c[i]);
+            this->nadirPoint[i] = std::max(this->nadirPoint[i], c[i]);
+        }
+    }
+}
+
 void Preprocessor::computeLowerBounds(const Graph& G) {
     CostArray INF_array;
     initialize(INF_array, MAX_COST);
@@ -181,5 +259,57 @@ void Preprocessor::computeLowerBounds(const Graph& G) {
         }
     } while (std::next_permutation(dimOrdering.begin(), dimOrdering.end()));
     std::reverse(lb.begin(), lb.end());
+
+    this->nodesCount = G.nodesCount;
+    this->cheapestEdges.assign(G.nodesCount * G.nodesCount, INF_array);
+    for (const Edge& edge : G.edges) {
+        CostArray& uv{this->cheapestEdges[edge.tail * G.nodesCount + edge.head]};
+        CostArray& vu{this->cheapestEdges[edge.head * G.nodesCount + edge.tail]};
+        for (Dimension d = 0; d < DIM; ++d) {
+            uv[d] = std::min(uv[d], edge.c[d]);
+            vu[d] = std::min(vu[d], edge.c[d]);
+        }
+    }
+}
+
+CostArray Preprocessor::subsetLowerBound(const NodesSubset& containedNodes) const {
+    assert(containedNodes.size() == this->nodesCount);
+    std::vector<Node> remainingNodes;
+    for (Node n = 0; n < this->nodesCount; ++n) {
+        if (!containedNodes[n]) {
+            remainingNodes.push_back(n);
+        }
+    }
+    CostArray bound{generate(0)};
+    std::vector<CostType> distance(remainingNodes.size());
+    std::vector<bool> connected(remainingNodes.size());
+    for (Dimension d = 0; d < DIM; ++d) {
+        //Dense Prim: the contained nodes form the root of the tree.
+        for (size_t i = 0; i < remainingNodes.size(); ++i) {
+            distance[i] = MAX_COST;
+            connected[i] = false;
+            for (size_t u = containedNodes.find_first(); u != NodesSubset::npos; u = containedNodes.find_next(u)) {
+                distance[i] = std::min(distance[i], this->cheapestEdges[u * this->nodesCount + remainingNodes[i]][d]);
+            }
+        }
+        for (size_t added = 0; added < remainingNodes.size(); ++added) {
+            size_t next = remainingNodes.size();
+            for (size_t i = 0; i < remainingNodes.size(); ++i) {
+                if (!connected[i] && (next == remainingNodes.size() || distance[i] < distance[next])) {
+                    next = i;
+                }
+            }
+            assert(distance[next] != MAX_COST);
+            connected[next] = true;
+            bound[d] += distance[next];
+            const CostArray* row = &this->cheapestEdges[remainingNodes[next] * this->nodesCount];
+            for (size_t i = 0; i < remainingNodes.size(); ++i) {
+                if (!connected[i]) {
+                    distance[i] = std::min(distance[i], row[remainingNodes[i]][d]);
+                }
+            }
+        }
+    }
+    return bound;
 }
 
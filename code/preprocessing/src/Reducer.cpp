@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cassert>
+
+#include "../../datastructures/includes/graph.h"
+#include "../../datastructures/includes/GraphCompacter.h"
+#include "../includes/Reducer.h"
+
+using namespace std;
+
+namespace {
+    //Tarjan's bridge search. Parallel edges are told apart by their ids, so they are never reported as bridges.
+    struct BridgeSearch {
+        explicit BridgeSearch(const Graph& G):
+            G{G}, discovery(G.nodesCount, 0), low(G.nodesCount, 0) {}
+
+        void search(Node u, EdgeId parentEdge) {
+            discovery[u] = low[u] = ++time;
+            for (const Arc& a : G.adjacentArcs(u)) {
+                if (a.idInEdgesVector == parentEdge) {
+                    continue;
+                }
+                if (discovery[a.n] != 0) {
+                    low[u] = min(low[u], discovery[a.n]);
+                    continue;
+                }
+                search(a.n, a.idInEdgesVector);
+                low[u] = min(low[u], low[a.n]);
+                if (low[a.n] > discovery[u]) {
+                    bridges.push_back(a.idInEdgesVector);
+                }
+            }
+        }
+
+        const Graph& G;
+        vector<size_t> discovery;
+        vector<size_t> low;
+        vector<EdgeId> bridges;
+        size_t time{0};
+    };
+}
+
+vector<EdgeId> findBridges(const Graph& G) {
+    BridgeSearch bridgeSearch(G);
+    for (Node u = 0; u < G.nodesCount; ++u) {
+        if (bridgeSearch.discovery[u] == 0) {
+            bridgeSearch.search(u, INVALID_ARC);
+        }
+    }
+    return bridgeSearch.bridges;
+}
+
+EdgeId findDominatingSeriesEdge(const Graph& G) {
+    for (Node u = 0; u < G.nodesCount; ++u) {
+        const Neighborhood& arcs{G.adjacentArcs(u)};
+        if (arcs.size() != 2 || arcs[0].n == arcs[1].n) {
+            continue;
+        }
+        if (dominates(arcs[0].c, arcs[1].c)) {
+            return arcs[0].idInEdgesVector;
+        }
+        if (dominates(arcs[1].c, arcs[0].c)) {
+            return arcs[1].idInEdgesVector;
+        }
+    }
+    return INVALID_ARC;
+}
+
+size_t reduce(GraphCompacter& gc) {
+    size_t contractedBefore = gc.contractedArcs;
+    while (gc.compactGraph.nodesCount > 1) {
+        //All bridges can be contracted at once since contracting a bridge does not affect the other bridges.
+        vector<EdgeId> forcedEdges = findBridges(gc.compactGraph);
+        if (forcedEdges.empty()) {
+            EdgeId seriesEdge = findDominatingSeriesEdge(gc.compactGraph);
+            if (seriesEdge == INVALID_ARC) {
+                break;
+            }
+            forcedEdges.push_back(seriesEdge);
+        }
+        gc.contract(forcedEdges);
+    }
+    return gc.contractedArcs - contractedBefore;
+}
@@ -0,0 +1,49 @@
+#ifndef ANYTIME_H_
+#define ANYTIME_H_
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "../../datastructures/includes/typedefs.h"
+
+/**
+ * Receives an efficient spanning tree as soon as a search makes it permanent at the target transition node: its cost
+ * vector and the ids of its edges in the searched graph, starting with the last edge added to the tree. The edges are
+ * empty if the search only computes costs (see Preprocessor::costsOnly).
+ */
+typedef std::function<void(const CostArray&, const std::vector<EdgeId>&)> TreeSink;
+
+/**
+ * Both searches make the efficient spanning trees permanent in lexicographic order. A search that is stopped early by
+ * the deadline or the solutions limit thus returns a certified partial front: every tree in it is efficient and every
+ * efficient tree that is lexicographically smaller than the last tree found is in it.
+ */
+struct AnytimeSettings {
+    TreeSink sink;
+    //Wall time limit in seconds. Zero means no limit.
+    double deadline{0};
+    //Maximum number of efficient spanning trees to compute. Zero means no limit.
+    size_t maxSolutions{0};
+
+    inline bool active() const {
+        return this->sink || this->deadline > 0 || this->maxSolutions > 0;
+    }
+
+    /**
+     * The clock is only read every 256 extractions.
+     */
+    inline bool limitReached(size_t solutions, size_t extractions,
+                             const std::chrono::high_resolution_clock::time_point& start) const {
+        if (this->maxSolutions > 0 && solutions >= this->maxSolutions) {
+            return true;
+        }
+        if (this->deadline > 0 && (extractions & 255) == 0) {
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            return elapsed.count() >= this->deadline;
+        }
+        return false;
+    }
+};
+
+#endif
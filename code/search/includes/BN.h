@@ -12,10 +12,12 @@
 #include "../../datastructures/includes/MemoryPool.h"
 #include "../../search/includes/Permanents.h"
 #include "ImplicitNodeBN.h"
+#include "../../preprocessing/includes/Preprocessor.h"
 #include "Solution.h"
+#include "Anytime.h"
+#include "Reclaimer.h"
 
 class Graph;
-class Preprocessor;
 
 namespace BN {
     typedef std::vector<PermanentQueueTree> Front;
@@ -23,10 +25,17 @@ namespace BN {
     class MultiobjectiveSearch {
         typedef ImplicitNodeBN<QueueTree> TransitionNode;
     public:
-        explicit MultiobjectiveSearch(const Graph &G);
+        MultiobjectiveSearch(const Graph &G, const Preprocessor& preprocessor);
 
         Solution run();
 
+        //The trees become permanent in lexicographic order, so a solutions limit stops the search early.
+        static constexpr bool lexicographicOrder{true};
+
+        void setAnytime(const AnytimeSettings& settings) {
+            this->anytime = settings;
+        }
+
         void printParetoFront(const std::list<QueueTree*>& targetFront, const ConnectedComponents &blueArcsComponents) const;
 
     private:
@@ -47,12 +56,23 @@ namespace BN {
                 NeighborhoodSize cutArcPosition,
                 Node newTreeNode);
 
+        /**
+         * Releases the transition node with the given index and its truncated front, keeping its statistics.
+         */
+        void releaseTransitionNode(long unsigned index);
+
         bool propagate(QueueTree* efficientTree, const TransitionNode &transitionNode, BinaryHeap<QueueTree, BN::CandidateLexComp> &H);
 
-        inline bool pruned(const CostArray &c) const;
+        inline bool pruned(const CostArray &c, size_t cardinality) const;
 
+        /**
+         * Inserts newLabel into the lexicographically sorted open trees unless a tree before it dominates it.
+         */
         bool merge(OpenCosts& open, QueueTree* newLabel);
 
+        /**
+         * Removes the open trees after newLabel that are dominated by it.
+         */
         void clean(OpenCosts& open, QueueTree* newLabel);
 
         void storeStatistics(Solution &sol);
@@ -67,15 +87,33 @@ namespace BN {
         std::vector<std::unique_ptr<TransitionNode>> implicitNodes;
         std::unordered_map<long unsigned, TruncatedFront> truncated;
         std::unique_ptr<Permanents> permanentTrees;
+        const Preprocessor& bounds;
+        const CostRounding rounding;
         const CostArray dominanceBound;
+        const TruncatedFront* targetFront{nullptr};
         const size_t targetNode;
+        AnytimeSettings anytime;
+        TransitionNodeReclaimer reclaimer;
+        size_t releasedTransitionNodes{0};
         size_t extractions;
         size_t insertions;
         size_t nqtIterations;
+        size_t prunedTrees{0};
     };
 
-    bool MultiobjectiveSearch::pruned(const CostArray& c) const {
-        return weakDominates(this->dominanceBound, c);// || isDominated(this->permanentTrees.at(targetNode), c);
+    //Prunes a subtree spanning cardinality many nodes if its costs plus the lower bound to complete it are dominated
+    //by the dominance bound, by the efficient spanning trees found so far or by a supported spanning tree.
+    bool MultiobjectiveSearch::pruned(const CostArray& c, size_t cardinality) const {
+        const CostArray bound = add(c, this->bounds.lb[cardinality - 1]);
+        if (truncatedDominance(*this->targetFront, this->rounding.round(bound))) {
+            return true;
+        }
+        //Trees behind these bounds are not necessarily part of an approximated front, see IGMDA::pruned.
+        if (!this->bounds.withinBudget(bound)) {
+            return true;
+        }
+        return this->rounding.exact &&
+               (weakDominates(this->dominanceBound, bound) || this->bounds.upperBoundDominance(bound));
     }
 
     struct ArcSorter {
@@ -0,0 +1,129 @@
+#ifndef BLOCK_DECOMPOSITION_H_
+#define BLOCK_DECOMPOSITION_H_
+
+#include <chrono>
+#include <vector>
+
+#include "../../datastructures/includes/graph.h"
+#include "../../datastructures/includes/Parallel.h"
+#include "../../preprocessing/includes/Preprocessor.h"
+#include "Solution.h"
+#include "Anytime.h"
+
+/**
+ * A biconnected block of a graph. Its nodes are relabeled from 0 to (number of nodes in the block) - 1 in the order
+ * of their ids in the decomposed graph, so the order of the adjacency lists is preserved.
+ */
+struct Block {
+    Graph graph;
+    std::vector<EdgeId> blockEdgeIds2EdgeIds;
+};
+
+/**
+ * Splits G at its articulation points. Every edge of G belongs to exactly one of the returned blocks.
+ */
+std::vector<Block> decompose(const Graph& G);
+
+/**
+ * Entry of the non-dominated Minkowski sum of two fronts. It remembers the positions of the summands.
+ */
+struct SumEntry {
+    CostArray c;
+    size_t lhsPosition;
+    size_t rhsPosition;
+};
+
+/**
+ * Computes all sums of a cost vector in lhs and a cost vector in rhs and keeps the non-dominated ones. Sums with
+ * equal costs are only kept once. The result is sorted lexicographically.
+ */
+std::vector<SumEntry> minkowskiSum(const std::vector<CostArray>& lhs, const std::vector<CostArray>& rhs);
+
+/**
+ * A spanning tree of G is the union of a spanning tree of every block of G. Hence, the efficient spanning trees of G
+ * are the non-dominated sums of the efficient spanning trees of the blocks.
+ * @param blockSolutions Solutions of the searches in the blocks. They are consumed.
+ * @param bounds Preprocessor of the decomposed graph. Sums that exceed its budget are discarded.
+ * @return Solution whose trees are expressed using the edge ids of the decomposed graph.
+ */
+Solution combineBlockSolutions(const std::vector<Block>& blocks, std::vector<Solution>& blockSolutions,
+                               const Preprocessor& bounds);
+
+/**
+ * Runs one instance of Search per block of the graph and combines their fronts. This way, the size of the
+ * transition space depends on the largest block and not on the whole graph. The blocks are solved in parallel. The
+ * lower bounds used for pruning are recomputed for every block, and the ideal points of the other blocks are added to
+ * the fixed costs of a block so that its search respects the budget. If the block fronts are
+ * (1+epsilon)-approximations, so is their combination. Trees of the whole graph only exist after the block fronts
+ * are combined, so a sink or a deadline makes the search run on the whole graph instead. The lexicographically
+ * smallest trees of the combined front cannot be obtained from prefixes of the block fronts either. Hence, a solutions
+ * limit also runs a Search with a lexicographicOrder on the whole graph, where it stops after the first trees. For the
+ * other searches, the blocks are solved completely and the limit just keeps the first trees of the sorted combined
+ * front.
+ */
+template <typename Search>
+class BlockSearch {
+public:
+    BlockSearch(const Graph& G, const Preprocessor& preprocessor):
+            G{G}, preprocessor{preprocessor} {}
+
+    void setAnytime(const AnytimeSettings& settings) {
+        this->anytime = settings;
+    }
+
+    Solution run() {
+        if (this->G.arcsCount == 0) {
+            return Solution();
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Block> blocks;
+        const bool stopsEarly{Search::lexicographicOrder && this->anytime.maxSolutions > 0};
+        if (!this->anytime.sink && this->anytime.deadline == 0 && !stopsEarly) {
+            blocks = decompose(this->G);
+        }
+        if (blocks.size() <= 1) {
+            Search search(this->G, this->preprocessor);
+            search.setAnytime(this->anytime);
+            return search.run();
+        }
+        std::vector<Preprocessor> blockBounds(blocks.size());
+        inParallel(blocks.size(), [this, &blocks, &blockBounds](size_t b) {
+            blockBounds[b].epsilon = this->preprocessor.epsilon;
+            blockBounds[b].budget = this->preprocessor.budget;
+            blockBounds[b].costsOnly = this->preprocessor.costsOnly;
+            blockBounds[b].computeBounds(blocks[b].graph);
+        });
+        CostArray idealPointsSum{generate(0)};
+        for (const Preprocessor& bounds : blockBounds) {
+            addInPlace(idealPointsSum, bounds.idealPoint);
+        }
+        for (Preprocessor& bounds : blockBounds) {
+            bounds.fixedCosts = add(this->preprocessor.fixedCosts, substract(idealPointsSum, bounds.idealPoint));
+        }
+        std::vector<Solution> blockSolutions(blocks.size());
+        inParallel(blocks.size(), [&blocks, &blockBounds, &blockSolutions](size_t b) {
+            Search search(blocks[b].graph, blockBounds[b]);
+            blockSolutions[b] = search.run();
+        });
+        Solution solution = combineBlockSolutions(blocks, blockSolutions, this->preprocessor);
+        if (this->anytime.maxSolutions > 0 && solution.trees > this->anytime.maxSolutions) {
+            solution.front.resize(this->anytime.maxSolutions);
+            if (!solution.spanningTreeIndices.empty()) {
+                solution.spanningTreeIndices.resize(this->anytime.maxSolutions);
+            }
+            solution.trees = this->anytime.maxSolutions;
+            solution.complete = false;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end - start;
+        solution.time = duration.count();
+        return solution;
+    }
+
+private:
+    const Graph& G;
+    const Preprocessor& preprocessor;
+    AnytimeSettings anytime;
+};
+
+#endif
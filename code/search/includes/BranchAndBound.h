@@ -0,0 +1,156 @@
+#ifndef BRANCH_AND_BOUND_H_
+#define BRANCH_AND_BOUND_H_
+
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+#include <vector>
+
+#include "boost/dynamic_bitset.hpp"
+
+#include "../../datastructures/includes/typedefs.h"
+#include "Solution.h"
+#include "Anytime.h"
+#include "Ranking.h"
+
+class Graph;
+class Preprocessor;
+
+//The lower bound set of a branch-and-bound node consists of the weighted sum MSTs for all integer weight vectors whose
+//entries add up to this value. The unit vectors among them yield the ideal point of the node.
+constexpr CostType BOUND_WEIGHTS_RESOLUTION = 3;
+
+namespace BranchAndBound {
+
+/**
+ * Part of the objective space in which cost vectors are not dominated by a given set of cost vectors: the union of the
+ * boxes {z : z < u} over the local upper bounds u of the set. The local upper bounds are updated as in Klamroth,
+ * Lacour and Vanderpooten (2015).
+ */
+class SearchRegion {
+public:
+    SearchRegion(): upperBounds(1, generate(MAX_COST)) {}
+
+    /**
+     * Removes the cost vectors that are dominated by or equal to f from the region.
+     */
+    void insert(const CostArray& f);
+
+    inline bool contains(const CostArray& z) const {
+        for (const CostArray& u : this->upperBounds) {
+            if (weakDominates(z, u)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * True if the region contains no cost vector z >= ideal with weights[j]*z >= values[j] for every j. Checks every
+     * box against every inequality separately, so the region may be disjoint from the lower bound set even if this
+     * is false.
+     */
+    bool excludes(const CostArray& ideal, const std::vector<Info<CostType>>& weights,
+                  const std::vector<uint64_t>& values) const;
+
+private:
+    std::vector<CostArray> upperBounds;
+};
+
+/**
+ * Subproblem of the branch-and-bound: the spanning trees that contain the forced edges and none of the excluded edges.
+ */
+struct Subproblem {
+    boost::dynamic_bitset<> forced;
+    boost::dynamic_bitset<> excluded;
+};
+
+/**
+ * Data of a thread that explores subproblems.
+ */
+struct Worker {
+    explicit Worker(Node nodesCount, size_t edgesCount, size_t weightsCount):
+            sets(nodesCount), trees(weightsCount), treeCosts(weightsCount), values(weightsCount),
+            occurrences(edgesCount, 0) {}
+
+    DisjointSets sets;
+    //Minimum spanning trees of the current subproblem w.r.t. the weight vectors of the lower bound set.
+    std::vector<std::vector<EdgeId>> trees;
+    std::vector<CostArray> treeCosts;
+    std::vector<uint64_t> values;
+    CostArray ideal{generate(0)};
+    std::vector<size_t> occurrences;
+    size_t subproblems{0};
+    size_t fathomed{0};
+};
+
+}
+
+/**
+ * Multiobjective branch-and-bound that branches on including or excluding an edge of the searched graph. Its memory
+ * only grows with the number of edges and the size of the front, so it also solves graphs that are too large for a
+ * transition node per node subset.
+ * The lower bound set of a subproblem is given by its MSTs w.r.t. the weighted sums of BOUND_WEIGHTS_RESOLUTION.
+ * These MSTs are feasible trees and update the incumbent front, which starts with the weighted sum MSTs of the whole
+ * graph. A subproblem is fathomed if its ideal point is pruned by the Preprocessor bounds or if no box of the search
+ * region of the incumbent front intersects its lower bound set. In the epsilon-approximate mode, the incumbent front and
+ * its search region hold costs rounded by CostRounding, and a subproblem is fathomed if the region does not contain
+ * its rounded ideal point. Otherwise, the search branches on a non-forced edge
+ * that is contained in some of the MSTs but not in all of them. If every MST has the costs of the ideal point, the
+ * subproblem is solved. The search tree is explored depth first, its first levels are expanded breadth first and the
+ * resulting subproblems are distributed among the threads, which share the incumbent front.
+ * As with TwoPhaseSearch, the trees are only known to be efficient at the end of the search. A sink receives them at
+ * the end, sorted lexicographically, and the solutions limit keeps the first trees of the sorted front. The limit is
+ * only a filter on the result and does not shorten the search.
+ */
+class BranchAndBoundSearch {
+public:
+    BranchAndBoundSearch(const Graph& G, const Preprocessor& preprocessor);
+    Solution run();
+
+    //The complete front is computed before the solutions limit is applied.
+    static constexpr bool lexicographicOrder{false};
+
+    void setAnytime(const AnytimeSettings& settings) {
+        this->anytime = settings;
+    }
+
+private:
+    /**
+     * Computes the lower bound set of the subproblem, updates the incumbent front with its MSTs and checks whether the
+     * subproblem is fathomed or solved.
+     * @return The edge to branch on, INVALID_ARC if the subproblem does not need to be branched.
+     */
+    EdgeId bound(BranchAndBound::Worker& worker, const BranchAndBound::Subproblem& subproblem);
+
+    void explore(BranchAndBound::Worker& worker, BranchAndBound::Subproblem& subproblem);
+
+    inline bool fathomed(const BranchAndBound::Worker& worker);
+
+    /**
+     * Adds a tree to the incumbent front unless its rounded costs are dominated by those of a tree in it. Trees whose
+     * rounded costs are dominated by those of the new one are removed.
+     */
+    void insert(const CostArray& c, const std::vector<EdgeId>& edges);
+
+    inline bool limitReached(size_t subproblems);
+
+private:
+    const Graph& graph;
+    const Preprocessor& bounds;
+    const CostRounding rounding;
+    AnytimeSettings anytime;
+    std::chrono::high_resolution_clock::time_point start;
+    std::atomic<bool> stopped{false};
+    std::vector<Info<CostType>> weights;
+    //Edge ids sorted by the weighted sum of every weight vector, ties broken lexicographically.
+    std::vector<std::vector<EdgeId>> orders;
+    //Position of the unit vector of every objective in weights.
+    Info<size_t> unitWeights;
+    std::vector<RoundedTree> front;
+    BranchAndBound::SearchRegion region;
+    std::shared_timed_mutex frontMutex;
+    size_t insertions{0};
+};
+
+#endif
@@ -5,11 +5,13 @@
 #ifndef BI_MST_IMPLICITNODE_H
 #define BI_MST_IMPLICITNODE_H
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include "../../datastructures/includes/typedefs.h"
 #include "../../datastructures/includes/Label.h"
+#include "../../preprocessing/includes/EdgeDominance.h"
 
 class Graph;
 typedef std::vector<OutgoingArcInfo> OutgoingArcs;
@@ -18,6 +20,7 @@ struct PredArc {
     PredArc() = default;
 
     mutable MultiPrim::List nextQueueTrees;
+    size_t tournamentPosition{std::numeric_limits<size_t>::max()}; ///< Position in the candidates tournament, if any.
 };
 
 template <typename LabelType>
@@ -25,13 +28,14 @@ class ImplicitNode {
     typedef std::vector<PredArc> IncomingArcs;
 public:
     /**
-     *
-     * @param originalGraph
+     * The outgoing arcs are only computed in expand(), which is first needed when a subtree spanning this node is
+     * extracted. Until then, the node only remembers the cut it is derived from.
      * @param nodes Passing by value is ok since we are moving the bitset into the 'containedNodes' member.
+     * @param existingCut Outgoing arcs of the predecessor. It must outlive the call to expand().
      */
-    ImplicitNode(const Graph& originalGraph, boost::dynamic_bitset<> nodes, long unsigned index, const OutgoingArcs& existingCut, Node newNode);
+    ImplicitNode(boost::dynamic_bitset<> nodes, long unsigned index, const OutgoingArcs& existingCut, Node newNode);
 
-    ImplicitNode(const Graph &originalGraph, Node initialNode);
+    ImplicitNode(const Graph &originalGraph, const EdgeDominance& dominance, Node initialNode);
 
     void print() const {
         std::cout << "\t\t\tImplicit Node with Index: " << this->getIndex() <<  " and cardinality: " << cardinality << std::endl;
@@ -42,6 +46,12 @@ public:
 
     inline bool initialized() const;
 
+    /**
+     * Computes the outgoing arcs if this has not happened yet.
+     * @return Number of outgoing arcs computed by this call.
+     */
+    inline size_t expand(const Graph& G, const EdgeDominance& dominance);
+
     inline const OutgoingArcs& outgoingArcs() const;
 
     inline size_t getIndex() const;
@@ -56,6 +66,26 @@ public:
 
     inline const PredArc& getIncomingArc(EdgeId id);
 
+    /**
+     * The non-empty candidate lists of the incoming arcs form a binary heap ordered by the costs of their first
+     * candidates, ties broken by the incoming arc id. Candidates must be added through these functions to keep the
+     * heap consistent with the lists.
+     */
+    inline void pushCandidateFront(EdgeId incomingArcId, LabelType* tree);
+
+    inline void pushCandidateBack(EdgeId incomingArcId, LabelType* tree);
+
+    /**
+     * @return The lexicographically smallest candidate among the first candidates of all lists, nullptr if all
+     * lists are empty.
+     */
+    inline LabelType* smallestCandidate() const;
+
+    /**
+     * Removes the smallest candidate from its list.
+     */
+    inline void popSmallestCandidate();
+
     inline LabelType* getQueueTree() {
         return this->queueTree;
     }
@@ -72,40 +102,63 @@ public:
         return this->incomingArcs.size();
     }
 
+    inline const CostArray& getLowerBound() const {
+        return this->lowerBound;
+    }
+
+    inline void setLowerBound(const CostArray& bound) {
+        this->lowerBound = bound;
+    }
+
 private:
     const NodesSubset containedNodes;
     const unsigned long index;
-    const std::unique_ptr<OutgoingArcs> outgoing;
+    std::unique_ptr<OutgoingArcs> outgoing;
+    const OutgoingArcs* predecessorCut{nullptr}; ///< Cut that the outgoing arcs are derived from, until expand().
+    Node addedNode{INVALID_NODE}; ///< Node that is not contained in the subset spanned by predecessorCut.
     IncomingArcs incomingArcs;
+    std::vector<EdgeId> candidatesTournament;
     LabelType* queueTree;
+    CostArray lowerBound{generate(0)}; ///< Lower bound on the costs needed to span the remaining nodes.
 
 private:
     const size_t cardinality;
 
 private:
-    void chenPruning(const Graph& G, OutgoingArcs& outgoingArcs);
+    inline bool candidatesBefore(EdgeId lhs, EdgeId rhs) const;
+
+    inline void placeInTournament(size_t position, EdgeId incomingArcId);
+
+    inline void candidatesUp(size_t position);
+
+    inline void candidatesDown(size_t position);
 
-    std::unique_ptr<OutgoingArcs> computeOutgoingArcsNew(const Graph& G, const OutgoingArcs& existingCut, Node newNode);
+    void chenPruning(const Graph& G, const EdgeDominance& dominance, OutgoingArcs& outgoingArcs);
 
-    std::unique_ptr<OutgoingArcs> computeOutgoingArcs(const Graph& G, Node initialNode);
+    std::unique_ptr<OutgoingArcs> computeOutgoingArcsNew(const Graph& G, const EdgeDominance& dominance,
+                                                         const OutgoingArcs& existingCut, Node newNode);
+
+    std::unique_ptr<OutgoingArcs> computeOutgoingArcs(const Graph& G, const EdgeDominance& dominance,
+                                                      Node initialNode);
 
     inline unsigned long computeIndex();
 
 };
 
 template <typename LabelType>
-ImplicitNode<LabelType>::ImplicitNode(const Graph& originalGraph, boost::dynamic_bitset<> nodes, long unsigned index, const OutgoingArcs& existingCut, Node newNode):
+ImplicitNode<LabelType>::ImplicitNode(boost::dynamic_bitset<> nodes, long unsigned index, const OutgoingArcs& existingCut, Node newNode):
         containedNodes{std::move(nodes)},
         index{index},
-        outgoing(computeOutgoingArcsNew(originalGraph, existingCut, newNode)),
+        predecessorCut{&existingCut},
+        addedNode{newNode},
         queueTree{nullptr},
         cardinality{this->containedNodes.count()} {}
 
 template <typename LabelType>
-ImplicitNode<LabelType>::ImplicitNode(const Graph &originalGraph, Node initialNode):
+ImplicitNode<LabelType>::ImplicitNode(const Graph &originalGraph, const EdgeDominance& dominance, Node initialNode):
         containedNodes(boost::dynamic_bitset<>(originalGraph.nodesCount, initialNode + 1)),
         index{this->computeIndex()},
-        outgoing(computeOutgoingArcs(originalGraph, initialNode)),
+        outgoing(computeOutgoingArcs(originalGraph, dominance, initialNode)),
         queueTree{nullptr},
         cardinality{1} {}
 
@@ -114,6 +167,17 @@ bool ImplicitNode<LabelType>::initialized() const {
     return this->outgoing != nullptr;
 }
 
+template <typename LabelType>
+size_t ImplicitNode<LabelType>::expand(const Graph& G, const EdgeDominance& dominance) {
+    if (this->initialized()) {
+        return 0;
+    }
+    assert(this->predecessorCut != nullptr);
+    this->outgoing = computeOutgoingArcsNew(G, dominance, *this->predecessorCut, this->addedNode);
+    this->predecessorCut = nullptr;
+    return this->outgoing->size();
+}
+
 template <typename LabelType>
 inline const PredArc& ImplicitNode<LabelType>::addIncomingArc() {
     this->incomingArcs.emplace_back();
@@ -126,6 +190,102 @@ inline const PredArc& ImplicitNode<LabelType>::getIncomingArc(EdgeId id) {
     return this->incomingArcs[id];
 }
 
+template <typename LabelType>
+void ImplicitNode<LabelType>::pushCandidateFront(EdgeId incomingArcId, LabelType* tree) {
+    PredArc& predArc = this->incomingArcs[incomingArcId];
+    predArc.nextQueueTrees.push_front(tree);
+    if (predArc.nextQueueTrees.size == 1) {
+        this->candidatesTournament.push_back(incomingArcId);
+        predArc.tournamentPosition = this->candidatesTournament.size() - 1;
+    }
+    //The new first candidate is not larger than the previous one.
+    this->candidatesUp(predArc.tournamentPosition);
+}
+
+template <typename LabelType>
+void ImplicitNode<LabelType>::pushCandidateBack(EdgeId incomingArcId, LabelType* tree) {
+    PredArc& predArc = this->incomingArcs[incomingArcId];
+    predArc.nextQueueTrees.push_back(tree);
+    if (predArc.nextQueueTrees.size == 1) {
+        this->candidatesTournament.push_back(incomingArcId);
+        predArc.tournamentPosition = this->candidatesTournament.size() - 1;
+        this->candidatesUp(predArc.tournamentPosition);
+    }
+}
+
+template <typename LabelType>
+LabelType* ImplicitNode<LabelType>::smallestCandidate() const {
+    if (this->candidatesTournament.empty()) {
+        return nullptr;
+    }
+    return this->incomingArcs[this->candidatesTournament.front()].nextQueueTrees.first;
+}
+
+template <typename LabelType>
+void ImplicitNode<LabelType>::popSmallestCandidate() {
+    assert(!this->candidatesTournament.empty());
+    PredArc& predArc = this->incomingArcs[this->candidatesTournament.front()];
+    predArc.nextQueueTrees.pop_front();
+    if (predArc.nextQueueTrees.empty()) {
+        predArc.tournamentPosition = std::numeric_limits<size_t>::max();
+        if (this->candidatesTournament.size() > 1) {
+            this->placeInTournament(0, this->candidatesTournament.back());
+        }
+        this->candidatesTournament.pop_back();
+    }
+    if (!this->candidatesTournament.empty()) {
+        this->candidatesDown(0);
+    }
+}
+
+template <typename LabelType>
+bool ImplicitNode<LabelType>::candidatesBefore(EdgeId lhs, EdgeId rhs) const {
+    const CostArray& lhsCosts = this->incomingArcs[lhs].nextQueueTrees.first->c;
+    const CostArray& rhsCosts = this->incomingArcs[rhs].nextQueueTrees.first->c;
+    if (lexSmaller(lhsCosts, rhsCosts)) {
+        return true;
+    }
+    return lhs < rhs && !lexSmaller(rhsCosts, lhsCosts);
+}
+
+template <typename LabelType>
+void ImplicitNode<LabelType>::placeInTournament(size_t position, EdgeId incomingArcId) {
+    this->candidatesTournament[position] = incomingArcId;
+    this->incomingArcs[incomingArcId].tournamentPosition = position;
+}
+
+template <typename LabelType>
+void ImplicitNode<LabelType>::candidatesUp(size_t position) {
+    const EdgeId moving = this->candidatesTournament[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (!this->candidatesBefore(moving, this->candidatesTournament[parent])) {
+            break;
+        }
+        this->placeInTournament(position, this->candidatesTournament[parent]);
+        position = parent;
+    }
+    this->placeInTournament(position, moving);
+}
+
+template <typename LabelType>
+void ImplicitNode<LabelType>::candidatesDown(size_t position) {
+    const EdgeId moving = this->candidatesTournament[position];
+    const size_t size = this->candidatesTournament.size();
+    while (2 * position + 1 < size) {
+        size_t child = 2 * position + 1;
+        if (child + 1 < size && this->candidatesBefore(this->candidatesTournament[child + 1], this->candidatesTournament[child])) {
+            ++child;
+        }
+        if (!this->candidatesBefore(this->candidatesTournament[child], moving)) {
+            break;
+        }
+        this->placeInTournament(position, this->candidatesTournament[child]);
+        position = child;
+    }
+    this->placeInTournament(position, moving);
+}
+
 template <typename LabelType>
 const OutgoingArcs& ImplicitNode<LabelType>::outgoingArcs() const {
     assert(this->initialized());
@@ -153,7 +313,23 @@ const NodesSubset& ImplicitNode<LabelType>::getNodes() const {
 }
 
 template <typename LabelType>
-void ImplicitNode<LabelType>::chenPruning(const Graph& G, OutgoingArcs& outgoingArcs) {
+void ImplicitNode<LabelType>::chenPruning(const Graph& G, const EdgeDominance& dominance, OutgoingArcs& outgoingArcs) {
+    if (dominance.indexed()) {
+        //An arc is pruned if one of the arcs before it dominates it. Its cut exit is pruned if one of these arcs leaves
+        //the subset through the same node, i.e., is incident to it, since both arcs then leave the cut together.
+        EdgeDominance::EdgeSet previous = dominance.emptySet();
+        for (OutgoingArcInfo& info : outgoingArcs) {
+            if (dominance.dominatedBySome(info.edgeId, previous)) {
+                info.chenPruned = true;
+                const Edge& edge = G.edges[info.edgeId];
+                Node newNodeInDominated = this->containedNodes[edge.head] ? edge.tail : edge.head;
+                assert(!this->containedNodes[newNodeInDominated]);
+                info.cutExitPruned = dominance.dominatedBySomeIncidentTo(info.edgeId, previous, newNodeInDominated);
+            }
+            EdgeDominance::insert(previous, info.edgeId);
+        }
+        return;
+    }
     for (size_t i = 0; i < outgoingArcs.size(); ++i) {
         const EdgeId edgeId = outgoingArcs[i].edgeId;
         const Edge& edge = G.edges[edgeId];
@@ -176,18 +352,14 @@ void ImplicitNode<LabelType>::chenPruning(const Graph& G, OutgoingArcs& outgoing
 
 template <typename LabelType>
 std::unique_ptr<OutgoingArcs> ImplicitNode<LabelType>::computeOutgoingArcsNew(
-        const Graph& G, const OutgoingArcs& existingCut, Node newNode) {
-    std::unique_ptr<OutgoingArcs> result = std::make_unique<OutgoingArcs>();
-    //First, add all outgoing edges from the old tree that do not end at the new node.
-    for (const OutgoingArcInfo& info : existingCut) {
+        const Graph& G, const EdgeDominance& dominance, const OutgoingArcs& existingCut, Node newNode) {
+    //The outgoing edges from the old tree that do not end at the new node stay in the cut.
+    auto stays = [&G, newNode](const OutgoingArcInfo& info) {
         const Edge& edge = G.edges[info.edgeId];
-        if (info.cutExitPruned || edge.tail == newNode || edge.head == newNode) {
-//        if (edge.tail == newNode || edge.head == newNode) {
-            continue;
-        }
-        result->push_back(OutgoingArcInfo(info));
-    }
-    //Now, add the adjacent edges from the newNode that do not end at a node contained in the old tree.
+        return !info.cutExitPruned && edge.tail != newNode && edge.head != newNode;
+    };
+    //The adjacent edges from the newNode that do not end at a node contained in the old tree enter the cut.
+    OutgoingArcs newArcs;
     const Neighborhood& neighborhood{G.node(newNode).adjacentArcs};
     for (const Arc& arc : neighborhood) {
         const Edge& edge = G.edges[arc.idInEdgesVector];
@@ -195,16 +367,34 @@ std::unique_ptr<OutgoingArcs> ImplicitNode<LabelType>::computeOutgoingArcsNew(
             continue;
         }
         if (!this->containedNodes[arc.n]) {
-            result->push_back(OutgoingArcInfo(arc.idInEdgesVector, false, false));
+            newArcs.push_back(OutgoingArcInfo(arc.idInEdgesVector, false, false));
         }
     }
-    std::sort(result->begin(), result->end(), OutgoingArcSorter(G));
-    chenPruning(G, *result);
+    OutgoingArcSorter sorter(G);
+    std::sort(newArcs.begin(), newArcs.end(), sorter);
+    //The existing cut is sorted already, so merging both sequences keeps the result sorted. The cuts are kept for
+    //the whole search, hence the result is allocated with its exact size.
+    std::unique_ptr<OutgoingArcs> result = std::make_unique<OutgoingArcs>();
+    result->reserve(std::count_if(existingCut.begin(), existingCut.end(), stays) + newArcs.size());
+    auto nextNewArc = newArcs.begin();
+    for (const OutgoingArcInfo& info : existingCut) {
+        if (!stays(info)) {
+            continue;
+        }
+        while (nextNewArc != newArcs.end() && sorter(*nextNewArc, info)) {
+            result->push_back(*nextNewArc++);
+        }
+        result->push_back(OutgoingArcInfo(info));
+    }
+    result->insert(result->end(), nextNewArc, newArcs.end());
+    assert(std::is_sorted(result->begin(), result->end(), sorter));
+    chenPruning(G, dominance, *result);
     return result;
 }
 
 template <typename LabelType>
-std::unique_ptr<OutgoingArcs> ImplicitNode<LabelType>::computeOutgoingArcs(const Graph& G, Node initialNode) {
+std::unique_ptr<OutgoingArcs> ImplicitNode<LabelType>::computeOutgoingArcs(const Graph& G, const EdgeDominance& dominance,
+                                                                           Node initialNode) {
     std::unique_ptr<OutgoingArcs> result = std::make_unique<OutgoingArcs>();
     const Neighborhood& neighborhood{G.node(initialNode).adjacentArcs};
     for (const Arc& arc : neighborhood) {
@@ -214,7 +404,7 @@ std::unique_ptr<OutgoingArcs> ImplicitNode<LabelType>::computeOutgoingArcs(const
         result->push_back(OutgoingArcInfo(arc.idInEdgesVector, false, false));
     }
     std::sort(result->begin(), result->end(), OutgoingArcSorter(G));
-    chenPruning(G, *result);
+    chenPruning(G, dominance, *result);
     return result;
 }
 
@@ -1,6 +1,7 @@
 #ifndef BN_IMPLICITNODE_H
 #define BN_IMPLICITNODE_H
 
+#include <list>
 #include <memory>
 #include <vector>
 #include <iostream>
@@ -35,9 +36,18 @@ public:
 
     inline const NodesSubset& getNodes() const;
 
+    /**
+     * Candidate subtrees spanning this node that were not extracted yet, sorted lexicographically. Only the first
+     * one is in the priority queue of the search.
+     */
+    inline std::list<LabelType*>& getOpenTrees() {
+        return this->openTrees;
+    }
+
 private:
     const NodesSubset containedNodes;
     const unsigned long index;
+    std::list<LabelType*> openTrees;
 
 private:
     const size_t cardinality;
@@ -11,6 +11,8 @@
 #include "Permanents.h"
 #include "ImplicitNode.h"
 #include "Solution.h"
+#include "Anytime.h"
+#include "Reclaimer.h"
 
 class Graph;
 
@@ -25,12 +27,17 @@ class Preprocessor;
 class IGMDA {
     typedef ImplicitNode<MultiPrim::SubTree> TransitionNode;
     public:
-        explicit IGMDA(const Graph& G);
+        IGMDA(const Graph& G, const Preprocessor& preprocessor);
         Solution run();
 
-    private:
+        //The trees become permanent in lexicographic order, so a solutions limit stops the search early.
+        static constexpr bool lexicographicOrder{true};
+
+        void setAnytime(const AnytimeSettings& settings) {
+            this->anytime = settings;
+        }
 
-        CostArray lowerBoundToTarget(const TransitionNode& tNode);
+    private:
 
         TransitionNode& getTransitionNode(const TransitionNode& predSubset, Node newNode, long unsigned decimalRepresentatio);
 
@@ -42,9 +49,19 @@ class IGMDA {
 
         void nextQueueTree(const MultiPrim::SubTree* recentlyExtracted, BinaryHeap<MultiPrim::SubTree, MultiPrim::CandidateLexComp>& heap, Pool<MultiPrim::SubTree>& treesPool);
 
+        /**
+         * Releases the transition node with the given index and its truncated front, keeping its statistics.
+         */
+        void releaseTransitionNode(long unsigned index, Pool<MultiPrim::SubTree>& treesPool);
+
         bool propagate(const MultiPrim::SubTree* predLabel, const TransitionNode& searchNode, BinaryHeap<MultiPrim::SubTree, MultiPrim::CandidateLexComp>& H, Pool<MultiPrim::SubTree>& treesPool);
 
-        inline bool pruned(const CostArray& c);
+        /**
+         * A subtree is pruned if its costs plus a lower bound on the costs to complete it are dominated by the
+         * dominance bound, by the efficient spanning trees found so far or by a supported spanning tree, or if they
+         * exceed the budget.
+         */
+        inline bool pruned(const CostArray& c, const CostArray& lowerBound) const;
 
         void storeStatistics(Solution& sol);
 
@@ -57,13 +74,21 @@ class IGMDA {
         std::unique_ptr<Permanents> permanentTrees;
         std::unordered_map<long unsigned, TruncatedFront> truncated;
         std::vector<std::unique_ptr<TransitionNode>> implicitNodes;
+        const Preprocessor& bounds;
+        const CostRounding rounding;
         const CostArray dominanceBound;
+        const TruncatedFront* targetFront{nullptr};
         const size_t targetNode;
+        AnytimeSettings anytime;
+        TransitionNodeReclaimer reclaimer;
+        size_t releasedTransitionNodes{0};
+        size_t releasedTransitionArcs{0};
         size_t solutionsCount{0};
         size_t extractions;
         size_t insertions;
         size_t nqtIterations;
         size_t transitionArcs{0};
+        size_t prunedTrees{0};
         size_t skipCounter{0};
     };
 
@@ -0,0 +1,178 @@
+#ifndef OBJECTIVE_ORDER_H_
+#define OBJECTIVE_ORDER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "../../datastructures/includes/graph.h"
+#include "../../preprocessing/includes/Preprocessor.h"
+#include "Solution.h"
+#include "Anytime.h"
+
+/**
+ * Runs Search with the objectives prioritized according to objectiveOrder: the trees are extracted in the
+ * lexicographic order that compares objective objectiveOrder[0] first, then objective objectiveOrder[1], and so on.
+ * The truncated fronts drop objectiveOrder[0], which is also the objective that is never approximated. Together with
+ * AnytimeSettings::maxSolutions, the search returns the k lexicographically best efficient trees under this priority.
+ * The costs of the searched graph are permuted internally. Solutions refer to trees by their edge ids, which do not
+ * change, and the sink receives costs in the original objective order. The permuted graph and its bounds are computed
+ * by the constructor, so the time of a run only contains the search and the search times of different orders are
+ * comparable. The time spent on the bounds is available as boundsDuration().
+ */
+template <typename Search>
+class ObjectiveOrderSearch {
+public:
+    ObjectiveOrderSearch(const Graph& G, const Preprocessor& preprocessor, const DimensionsVector& objectiveOrder):
+            G{G}, preprocessor{preprocessor}, objectiveOrder{objectiveOrder} {
+        if (!std::is_permutation(objectiveOrder.begin(), objectiveOrder.end(), standardSorting().begin())) {
+            printf("The objective order has to be a permutation of the objectives 0,...,%u.\n", DIM - 1);
+            exit(1);
+        }
+        if (objectiveOrder == standardSorting()) {
+            return;
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        this->permutedGraph = permuteCosts(G, objectiveOrder);
+        for (Dimension i = 0; i < DIM; ++i) {
+            this->permutedBounds.epsilon[i] = preprocessor.epsilon[objectiveOrder[i]];
+            this->inverseOrder[objectiveOrder[i]] = i;
+        }
+        this->permutedBounds.budget = sorted(preprocessor.budget, objectiveOrder);
+        this->permutedBounds.fixedCosts = sorted(preprocessor.fixedCosts, objectiveOrder);
+        this->permutedBounds.costsOnly = preprocessor.costsOnly;
+        this->permutedBounds.computeBounds(this->permutedGraph);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        this->boundsTime = duration.count();
+    }
+
+    void setAnytime(const AnytimeSettings& settings) {
+        this->anytime = settings;
+    }
+
+    Solution run() {
+        if (this->objectiveOrder == standardSorting()) {
+            Search search(this->G, this->preprocessor);
+            search.setAnytime(this->anytime);
+            return search.run();
+        }
+        AnytimeSettings permutedAnytime{this->anytime};
+        if (this->anytime.sink) {
+            TreeSink sink{this->anytime.sink};
+            const DimensionsVector inverse{this->inverseOrder};
+            permutedAnytime.sink = [sink, inverse](const CostArray& c, const std::vector<EdgeId>& edgeIds) {
+                sink(sorted(c, inverse), edgeIds);
+            };
+        }
+        Search search(this->permutedGraph, this->permutedBounds);
+        search.setAnytime(permutedAnytime);
+        Solution solution = search.run();
+        for (CostArray& c : solution.front) {
+            c = sorted(c, this->inverseOrder);
+        }
+        return solution;
+    }
+
+    /**
+     * Time in seconds spent on computing the bounds for the permuted costs. Zero for the standard order, which uses
+     * the given preprocessor.
+     */
+    double boundsDuration() const {
+        return this->boundsTime;
+    }
+
+private:
+    const Graph& G;
+    const Preprocessor& preprocessor;
+    const DimensionsVector objectiveOrder;
+    DimensionsVector inverseOrder{};
+    Graph permutedGraph;
+    Preprocessor permutedBounds;
+    AnytimeSettings anytime;
+    double boundsTime{0};
+};
+
+/**
+ * The Pareto sets at the transition nodes do not depend on the objective order, but the truncated fronts do: they
+ * only contain the non-dominated costs in the objectives other than the lexicographic primary. Hence, only the primary
+ * matters and there are DIM candidate orders, each one a primary followed by the remaining objectives in their
+ * natural order. They are returned sorted by decreasing mean correlation of the edge costs in the objectives that
+ * are kept in the truncated fronts, since correlated objectives tend to yield small truncated fronts.
+ */
+std::vector<DimensionsVector> rankObjectiveOrders(const Graph& G);
+
+struct OrderBenchmark {
+    DimensionsVector order;
+    double time;
+    size_t trees;
+    size_t extractions;
+};
+
+/**
+ * Runs Search to completion once with every order in orders, e.g., the candidates of rankObjectiveOrders, to compare
+ * them across instance families. Only lexicographic orders are supported: orders by (weighted) sums of the costs are
+ * monotone with respect to dominance as well, but the truncated fronts rely on every subtree extracted before a
+ * subtree at the same transition node having primary costs that are not larger.
+ */
+template <typename Search>
+std::vector<OrderBenchmark> benchmarkObjectiveOrders(const Graph& G, const Preprocessor& preprocessor,
+                                                     const std::vector<DimensionsVector>& orders) {
+    std::vector<OrderBenchmark> results;
+    for (const DimensionsVector& order : orders) {
+        ObjectiveOrderSearch<Search> search(G, preprocessor, order);
+        Solution solution = search.run();
+        results.push_back({order, solution.time, solution.trees, solution.extractions});
+    }
+    return results;
+}
+
+/**
+ * Picks the objective order for Search. Every candidate of rankObjectiveOrders runs for at most samplingTime seconds.
+ * A candidate that finishes is rated by its running time. Otherwise, its total running time is extrapolated from the
+ * share of the supported trees in preprocessor.upperBoundSet whose primary costs do not exceed those of the last
+ * efficient tree found. Ties, e.g., if no candidate finds a tree in time, keep the correlation ranking.
+ * Only search times are compared: the bounds of a candidate order are computed when its ObjectiveOrderSearch is
+ * constructed, before the sampling deadline starts, so that the standard order, which reuses the given bounds, has no
+ * advantage.
+ */
+template <typename Search>
+DimensionsVector selectObjectiveOrder(const Graph& G, const Preprocessor& preprocessor, double samplingTime) {
+    std::vector<DimensionsVector> candidates = rankObjectiveOrders(G);
+    if (G.arcsCount == 0 || samplingTime <= 0 || preprocessor.upperBoundSet.empty()) {
+        return candidates.front();
+    }
+    DimensionsVector bestOrder{candidates.front()};
+    double bestEstimate{std::numeric_limits<double>::max()};
+    for (const DimensionsVector& order : candidates) {
+        const Dimension primary{order[0]};
+        CostType lastPrimaryCost{0};
+        AnytimeSettings sampling;
+        sampling.deadline = samplingTime;
+        sampling.sink = [primary, &lastPrimaryCost](const CostArray& c, const std::vector<EdgeId>&) {
+            lastPrimaryCost = c[primary];
+        };
+        ObjectiveOrderSearch<Search> search(G, preprocessor, order);
+        search.setAnytime(sampling);
+        Solution solution = search.run();
+        //solution.time excludes search.boundsDuration(), just like the deadline does.
+        double estimate{solution.time};
+        if (!solution.complete) {
+            double progress = std::count_if(
+                    preprocessor.upperBoundSet.begin(), preprocessor.upperBoundSet.end(),
+                    [primary, lastPrimaryCost](const CostArray& c) { return c[primary] <= lastPrimaryCost; });
+            estimate = solution.trees > 0 && progress > 0 ?
+                       solution.time * preprocessor.upperBoundSet.size() / progress :
+                       std::numeric_limits<double>::max();
+        }
+        if (estimate < bestEstimate) {
+            bestEstimate = estimate;
+            bestOrder = order;
+        }
+    }
+    return bestOrder;
+}
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef PERMANENTS_H_
 #define PERMANENTS_H_
 
+#include <array>
 #include <cassert>
+#include <limits>
 #include <vector>
 #include "../../datastructures/includes/typedefs.h"
 
@@ -49,10 +51,62 @@ public:
         return this->elements[rowIndex][indexInRow];
     }
 
+    /**
+     * Walks the chain of permanent subtrees that ends at index.
+     * @return The last arcs of the length subtrees in the chain, starting with the one at index.
+     */
+    inline std::vector<EdgeId> getChain(size_t index, size_t length) const {
+        std::vector<EdgeId> chain;
+        chain.reserve(length);
+        PermanentTree const *tree = &this->getElement(index);
+        chain.push_back(tree->lastArc);
+        while (chain.size() < length) {
+            tree = &this->getElement(tree->predLabelPosition);
+            chain.push_back(tree->lastArc);
+        }
+        return chain;
+    }
+
     inline size_t size() const {
         return (this->elements.size()-1)*labelsPerRow + currentIndex;
     }
 
+    /**
+     * Drops every permanent subtree that is not part of a chain of length subtrees ending at one of chainEnds. The
+     * kept subtrees keep their relative order, so predecessors are still stored before their successors.
+     * @param chainEnds Updated to the new positions of the chain ends.
+     */
+    inline void compact(std::vector<size_t>& chainEnds, size_t length) {
+        std::vector<bool> reachable(this->size(), false);
+        for (size_t end : chainEnds) {
+            size_t index = end;
+            //Chains share their prefixes, so a walk stops at the first subtree that is already marked.
+            for (size_t i = 0; i < length && !reachable[index]; ++i) {
+                reachable[index] = true;
+                index = this->getElement(index).predLabelPosition;
+            }
+        }
+        std::vector<size_t> newIndices(this->size(), std::numeric_limits<size_t>::max());
+        Permanents compacted;
+        for (size_t index = 0; index < reachable.size(); ++index) {
+            if (!reachable[index]) {
+                continue;
+            }
+            const PermanentTree& tree{this->getElement(index)};
+            size_t predIndex = std::numeric_limits<size_t>::max();
+            if (tree.predLabelPosition < index && reachable[tree.predLabelPosition]) {
+                predIndex = newIndices[tree.predLabelPosition];
+            }
+            newIndices[index] = compacted.getCurrentIndex();
+            compacted.addElement(predIndex, tree.lastArc);
+        }
+        for (size_t& end : chainEnds) {
+            end = newIndices[end];
+        }
+        std::swap(this->elements, compacted.elements);
+        this->currentIndex = compacted.currentIndex;
+    }
+
 private:
     void increaseIndex() {
         if (currentIndex + 1 == labelsPerRow) {
@@ -0,0 +1,172 @@
+#ifndef RANKING_H_
+#define RANKING_H_
+
+#include <functional>
+#include <vector>
+
+#include "boost/dynamic_bitset.hpp"
+
+#include "../../datastructures/includes/typedefs.h"
+#include "Solution.h"
+#include "Anytime.h"
+
+class Graph;
+
+/**
+ * Union-find structure with path halving for Kruskal's algorithm.
+ */
+class DisjointSets {
+public:
+    explicit DisjointSets(Node nodesCount): parent(nodesCount) {}
+
+    inline void reset() {
+        for (Node n = 0; n < this->parent.size(); ++n) {
+            this->parent[n] = n;
+        }
+    }
+
+    inline Node find(Node n) {
+        while (this->parent[n] != n) {
+            this->parent[n] = this->parent[this->parent[n]];
+            n = this->parent[n];
+        }
+        return n;
+    }
+
+    /**
+     * @return False if u and v are in the same set already.
+     */
+    inline bool unite(Node u, Node v) {
+        Node uRoot = this->find(u);
+        Node vRoot = this->find(v);
+        if (uRoot == vRoot) {
+            return false;
+        }
+        this->parent[uRoot] = vRoot;
+        return true;
+    }
+
+private:
+    std::vector<Node> parent;
+};
+
+namespace Ranking {
+
+/**
+ * Spanning trees that contain the forced edges and none of the excluded edges, except for mst which has been
+ * enumerated already. The next tree of the subproblem is mst with swapOut replaced by swapIn.
+ */
+struct Subproblem {
+    std::vector<EdgeId> mst;
+    CostArray c{generate(0)};
+    boost::dynamic_bitset<> forced;
+    boost::dynamic_bitset<> excluded;
+    EdgeId swapOut{INVALID_ARC};
+    EdgeId swapIn{INVALID_ARC};
+    //Costs and weighted costs of the next tree.
+    CostArray next{generate(0)};
+    uint64_t key{0};
+};
+
+//Ties in the weighted costs of the next trees are broken lexicographically.
+struct SubproblemComparison {
+    inline bool operator() (const Subproblem& lhs, const Subproblem& rhs) const {
+        return lhs.key > rhs.key || (lhs.key == rhs.key && lexSmaller(rhs.next, lhs.next));
+    }
+};
+
+}
+
+/**
+ * Enumerates the spanning trees of a graph in non-decreasing order of their weighted costs, as in the algorithm of
+ * Katoh, Ibaraki and Mine. The second cheapest tree of a subproblem differs from its minimum spanning tree by a single
+ * edge swap, so every subproblem only stores its minimum spanning tree and its best swap. Extracting a subproblem
+ * yields its next tree and splits the remaining trees into the subproblem that excludes the swapped out edge and the
+ * one that forces it. Both reuse the trees of their parent. Trees are computed lazily, one per call to next. Ties in
+ * the weighted costs of the edges are broken lexicographically, so the first tree is a lexicographically optimal
+ * tree among the minimum weighted ones.
+ */
+class SpanningTreeRanking {
+public:
+    SpanningTreeRanking(const Graph& G, const Info<CostType>& weights);
+
+    /**
+     * Computes the next tree of the ranking.
+     * @return False if every spanning tree has been enumerated.
+     */
+    bool next();
+
+    const CostArray& costs() const {
+        return this->currentCosts;
+    }
+
+    const std::vector<EdgeId>& edges() const {
+        return this->currentTree;
+    }
+
+    /**
+     * The (at most) k cheapest spanning trees, in the order of the ranking.
+     */
+    Solution kBest(size_t k);
+
+private:
+    inline uint64_t weightedCosts(const CostArray& c) const;
+
+    /**
+     * Computes the best swap of the subproblem and inserts it into the heap, unless the subproblem contains no other
+     * tree.
+     */
+    void insert(Ranking::Subproblem&& subproblem);
+
+    /**
+     * Determines the non-tree edge and the non-forced tree edge on its cycle whose swap increases the weighted costs
+     * the least.
+     * @return False if no such pair exists.
+     */
+    bool findBestSwap(Ranking::Subproblem& subproblem);
+
+private:
+    const Graph& graph;
+    const Info<CostType> weights;
+    //Edge ids sorted by weighted costs, ties broken lexicographically.
+    std::vector<EdgeId> order;
+    std::vector<Ranking::Subproblem> heap;
+    std::vector<EdgeId> currentTree;
+    CostArray currentCosts{generate(0)};
+    bool started{false};
+    size_t extractions{0};
+    size_t insertions{0};
+    //Buffers for the rooted version of a tree, see findBestSwap.
+    std::vector<Node> treeParent;
+    std::vector<EdgeId> treeParentEdge;
+    std::vector<size_t> depth;
+    std::vector<Node> stack;
+    std::vector<std::vector<std::pair<Node, EdgeId>>> treeAdjacency;
+};
+
+/**
+ * Tree found by a search that only knows at the end of the search which of its trees are efficient.
+ */
+struct RoundedTree {
+    CostArray c;
+    //Costs rounded by the CostRounding of the search, equal to c if the search is exact.
+    CostArray rounded;
+    std::vector<EdgeId> edges;
+};
+
+/**
+ * Passes the minimum spanning tree w.r.t. every weighted sum of weightedSumWeights() to insert. These trees are
+ * supported efficient trees.
+ * @return False if G is not connected.
+ */
+bool collectSupportedTrees(const Graph& G,
+                           const std::function<void(const CostArray&, const std::vector<EdgeId>&)>& insert);
+
+/**
+ * Sorts the final front of a search lexicographically, applies the solutions limit and stores the trees in solution,
+ * only their costs if costsOnly is set. The sink receives every stored tree. Sets solution.trees and marks the
+ * solution as incomplete if the limit removed trees.
+ */
+void emitFront(std::vector<RoundedTree>& front, const AnytimeSettings& anytime, bool costsOnly, Solution& solution);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef BI_MST_RECLAIMER_H
+#define BI_MST_RECLAIMER_H
+
+#include <cassert>
+#include <vector>
+
+#include "../../datastructures/includes/typedefs.h"
+
+/**
+ * Decides when the transition nodes of a search can be released. Subtrees spanning k nodes are only built when a
+ * subtree spanning k-1 nodes is extracted. Hence, once the priority queue holds no subtree spanning less than k
+ * nodes, transition nodes of cardinality below k can never receive new subtrees. Their cuts are kept one layer
+ * longer since not yet expanded successors still refer to them.
+ */
+class TransitionNodeReclaimer {
+public:
+    explicit TransitionNodeReclaimer(size_t nodesCount):
+            queued(nodesCount + 1, 0), transitionNodes(nodesCount + 1) {}
+
+    inline void created(size_t cardinality, long unsigned index) {
+        assert(cardinality >= this->releasedLayers);
+        this->transitionNodes[cardinality].push_back(index);
+    }
+
+    inline void pushed(size_t cardinality) {
+        assert(cardinality >= this->lowestQueued);
+        ++this->queued[cardinality];
+    }
+
+    inline void popped(size_t cardinality) {
+        assert(this->queued[cardinality] > 0);
+        --this->queued[cardinality];
+    }
+
+    /**
+     * Calls release(index) for every transition node that became unreachable since the last call. Must not be called
+     * between the extraction of a subtree and the end of its propagation.
+     */
+    template <typename Release>
+    void releaseUnreachable(Release release) {
+        while (this->lowestQueued < this->queued.size() && this->queued[this->lowestQueued] == 0) {
+            ++this->lowestQueued;
+        }
+        //The last layer holds the target node, whose front is the result of the search.
+        while (this->releasedLayers + 1 < this->lowestQueued && this->releasedLayers + 1 < this->queued.size() - 1) {
+            for (long unsigned index : this->transitionNodes[this->releasedLayers]) {
+                release(index);
+            }
+            std::vector<long unsigned>().swap(this->transitionNodes[this->releasedLayers]);
+            ++this->releasedLayers;
+        }
+    }
+
+private:
+    std::vector<size_t> queued; ///< Number of subtrees in the priority queue per cardinality.
+    std::vector<std::vector<long unsigned>> transitionNodes; ///< Transition nodes per cardinality.
+    size_t lowestQueued{0};
+    size_t releasedLayers{0};
+};
+
+#endif //BI_MST_RECLAIMER_H
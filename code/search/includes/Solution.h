@@ -18,13 +18,35 @@ struct Solution {
         transitionArcsCount{0},
         transitionNodes{0},
         transitionArcs{0},
+        prunedTrees{0},
         time{0} {}
 
     void printSpanningTrees(const GraphCompacter& compactGraph);
 
+    /**
+     * Prints the edges of a tree in the original graph and its costs.
+     * @param edgeIds Ids of the tree's edges in the compact graph.
+     */
+    static void printSpanningTree(const GraphCompacter& compactGraph, const std::vector<EdgeId>& edgeIds);
+
+    /**
+     * Walks the chain of permanent subtrees that ends at treeIndex.
+     * @param edgesCount Number of edges in the tree, i.e., number of nodes in the searched graph minus one.
+     * @return Ids of the tree's edges in the searched graph, starting with the last edge added to the tree.
+     */
+    std::vector<EdgeId> getEdges(size_t treeIndex, size_t edgesCount) const;
+
+    /**
+     * Stores a tree given by its edges as a new chain in the permanents and registers it as a solution.
+     */
+    void addSpanningTree(const std::vector<EdgeId>& edgeIds);
+
 
     std::vector<size_t> spanningTreeIndices;
     std::unique_ptr<Permanents> permanents;
+    //Costs of the efficient trees in the searched graph, in the order of spanningTreeIndices. Only the costs are
+    //stored if the search ran with Preprocessor::costsOnly, spanningTreeIndices is empty then.
+    std::vector<CostArray> front;
 
     std::size_t trees{0};
     std::size_t extractions{0};
@@ -33,6 +55,9 @@ struct Solution {
     std::size_t transitionArcsCount{0};
     std::size_t transitionNodes{0};
     std::size_t transitionArcs{0};
+    std::size_t prunedTrees{0};
+    //False if the search was stopped by a limit of its AnytimeSettings.
+    bool complete{true};
     double time{0};
 };
 
@@ -0,0 +1,111 @@
+#ifndef TWO_PHASE_H_
+#define TWO_PHASE_H_
+
+#include <vector>
+
+#include "boost/dynamic_bitset.hpp"
+
+#include "../../datastructures/includes/typedefs.h"
+#include "Solution.h"
+#include "Anytime.h"
+#include "Ranking.h"
+
+class Graph;
+class Preprocessor;
+
+namespace TwoPhase {
+
+/**
+ * Spanning trees that contain the forced edges and none of the excluded edges. Phase two partitions the spanning
+ * trees of the graph into such subproblems.
+ */
+struct Subproblem {
+    //Minimum spanning tree of the subproblem w.r.t. the ranking key. Its first forcedCount edges are the forced edges.
+    std::vector<EdgeId> tree;
+    boost::dynamic_bitset<> excluded;
+    size_t forcedCount{0};
+    CostArray c{generate(0)};
+    //Ideal point of the subproblem: entry i contains the costs of a minimum spanning tree w.r.t. objective i.
+    CostArray lowerBound{generate(0)};
+    uint64_t key{0};
+};
+
+//Subproblems are ranked by the key of their minimum spanning tree, ties are broken lexicographically.
+struct SubproblemComparison {
+    inline bool operator() (const Subproblem& lhs, const Subproblem& rhs) const {
+        return lhs.key > rhs.key || (lhs.key == rhs.key && lexSmaller(rhs.c, lhs.c));
+    }
+};
+
+}
+
+/**
+ * Two-phase method. Phase one computes supported efficient trees as minimum spanning trees w.r.t. weighted sums of the
+ * objectives. Phase two ranks the spanning trees by the sum of their costs. The trees are partitioned into subproblems
+ * as in Lawler's ranking scheme, and a subproblem is discarded as soon as a tree found so far dominates its ideal
+ * point. The supported trees from phase one let the ranking discard most subproblems early. The memory depends on the
+ * number of open subproblems and not on the number of node subsets.
+ * The trees are only known to be efficient once the ranking ends. Hence, a sink receives them at the end of the search,
+ * sorted lexicographically, and the solutions limit keeps the first trees of the sorted front. The limit is only a
+ * filter on the result: the search takes as long as without it. A search stopped by the deadline returns mutually
+ * non-dominated trees that are not necessarily efficient.
+ */
+class TwoPhaseSearch {
+public:
+    TwoPhaseSearch(const Graph& G, const Preprocessor& preprocessor);
+    Solution run();
+
+    //The complete front is computed before the solutions limit is applied.
+    static constexpr bool lexicographicOrder{false};
+
+    void setAnytime(const AnytimeSettings& settings) {
+        this->anytime = settings;
+    }
+
+private:
+    /**
+     * Kruskal's algorithm that starts with the first forcedCount edges of tree and scans the remaining edges in the
+     * given order, skipping the excluded ones.
+     * @return False if the forced edges cannot be completed to a spanning tree.
+     */
+    bool completeTree(const std::vector<EdgeId>& order, size_t forcedCount, const boost::dynamic_bitset<>& excluded,
+                      std::vector<EdgeId>& tree);
+
+    /**
+     * Computes the minimum spanning tree, its key and the ideal point of a subproblem whose forced edges are the
+     * first forcedCount edges of its tree.
+     * @return False if the subproblem contains no spanning tree.
+     */
+    bool solve(TwoPhase::Subproblem& subproblem);
+
+    /**
+     * A subproblem is pruned if its ideal point is dominated by a tree found so far or exceeds the budget.
+     */
+    inline bool pruned(const CostArray& lowerBound) const;
+
+    /**
+     * Adds a tree to the front unless a tree found so far dominates it. Trees dominated by the new one are removed.
+     */
+    void insert(const CostArray& c, const std::vector<EdgeId>& edges);
+
+    inline uint64_t rankingKey(const CostArray& c) const;
+
+    void storeStatistics(Solution& sol) const;
+
+private:
+    const Graph& graph;
+    const Preprocessor& bounds;
+    const CostRounding rounding;
+    AnytimeSettings anytime;
+    //Edge ids sorted by the ranking key, and sorted by every single objective for the ideal points.
+    std::vector<EdgeId> rankingOrder;
+    Info<std::vector<EdgeId>> objectiveOrders;
+    std::vector<RoundedTree> front;
+    DisjointSets sets;
+    std::vector<EdgeId> treeBuffer;
+    size_t extractions{0};
+    size_t insertions{0};
+    size_t prunedSubproblems{0};
+};
+
+#endif
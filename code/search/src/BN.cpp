@@ -21,12 +21,15 @@ inline static boost::dynamic_bitset<> addNode(const boost::dynamic_bitset<>& exi
     return n;
 }
 
-MultiobjectiveSearch::MultiobjectiveSearch(const Graph &G):
+MultiobjectiveSearch::MultiobjectiveSearch(const Graph &G, const Preprocessor& preprocessor):
     G{G},
     implicitNodes((1UL<<(this->G.nodesCount - 1))),
     permanentTrees(std::make_unique<Permanents>()),
-    dominanceBound(generate(MAX_COST)),
+    bounds{preprocessor},
+    rounding(preprocessor.epsilon, G.nodesCount - 1),
+    dominanceBound(preprocessor.dominanceBound),
     targetNode{(1UL<<(this->G.nodesCount-1))-1},
+    reclaimer(G.nodesCount),
     extractions{0},
     insertions{0},
     nqtIterations{0} {
@@ -46,6 +49,7 @@ MultiobjectiveSearch::TransitionNode& MultiobjectiveSearch::intializeSubset(
             std::make_unique<TransitionNode>(std::move(bitRepresentation), decimalRepresentation);
     //assert(this->implicitNodes[newSubset->getIndex()] == nullptr);
     long unsigned index = newSubset->getIndex();
+    this->reclaimer.created(newSubset->getCardinality(), index);
     this->implicitNodes[index] = std::move(newSubset);
     return *this->implicitNodes[index];
 }
@@ -125,38 +129,71 @@ Solution MultiobjectiveSearch::run() {
     initialTree->addedNode2Index.emplace(0,0);
     initialTree->addedNodesInOrder.push_back(0);
     std::unique_ptr<TransitionNode> initialImplicitNode = std::make_unique<TransitionNode>(this->G, 0);
+    this->reclaimer.created(1, initialImplicitNode->getIndex());
     this->implicitNodes[initialImplicitNode->getIndex()] = std::move(initialImplicitNode);
-    this->truncated.emplace(targetNode, TruncatedFront());
+    this->targetFront = &this->truncated.emplace(targetNode, TruncatedFront()).first->second;
     QueueTree* efficientTree;
 
     BinaryHeap<QueueTree, CandidateLexComp> heap;
-//    BinaryHeap<QueueTree, LS_sum> heap;
     heap.push(initialTree);
+    this->reclaimer.pushed(1);
     auto start = std::chrono::high_resolution_clock::now();
     while (heap.size() != 0) {
+        if (this->anytime.limitReached(solution.front.size(), extractions, start)) {
+            solution.complete = false;
+            break;
+        }
+        this->reclaimer.releaseUnreachable([this](long unsigned index) { this->releaseTransitionNode(index); });
         efficientTree = heap.pop();
         long unsigned currentTransitionNodeId = efficientTree->n;
         TransitionNode& currentTransitionNode{*this->implicitNodes[currentTransitionNodeId]};
         assert(currentTransitionNode.getIndex() == currentTransitionNodeId);
+        this->reclaimer.popped(currentTransitionNode.getCardinality());
+        //The next open tree of the transition node replaces the extracted one in the heap.
+        OpenCosts& open{currentTransitionNode.getOpenTrees()};
+        if (!open.empty()) {
+            assert(open.front() == efficientTree);
+            open.pop_front();
+            if (!open.empty()) {
+                heap.push(open.front());
+                this->reclaimer.pushed(currentTransitionNode.getCardinality());
+            }
+        }
         TruncatedFront& currentFront{this->truncated[currentTransitionNode.getIndex()]};
-        bool inserted = truncatedInsertionLazy(currentFront, efficientTree->c);
+        bool inserted = truncatedInsertionLazy(currentFront, this->rounding.round(efficientTree->c));
         if (!inserted) {
             this->treePool.free(efficientTree);
             continue;
         }
 
         if (currentTransitionNodeId == targetNode) {
+            solution.front.push_back(efficientTree->c);
+            if (this->bounds.costsOnly) {
+                if (this->anytime.sink) {
+                    this->anytime.sink(efficientTree->c, std::vector<EdgeId>());
+                }
+                continue;
+            }
             size_t solutionIndex = this->permanentTrees->getCurrentIndex();
             EdgeId lastEdgeId = retrieveEdgeId(efficientTree);
             permanentTrees->addElement(efficientTree->predLabelPosition, lastEdgeId);
             solution.spanningTreeIndices.push_back(solutionIndex);
+            if (this->anytime.sink) {
+                this->anytime.sink(efficientTree->c, this->permanentTrees->getChain(solutionIndex, this->G.nodesCount - 1));
+            }
             continue;
         }
         extractions++;
         assert(currentTransitionNode.getIndex() == currentTransitionNodeId);
+        //The target front might have grown since efficientTree was inserted into the heap.
+        if (pruned(efficientTree->c, currentTransitionNode.getCardinality())) {
+            ++prunedTrees;
+            this->treePool.free(efficientTree);
+            continue;
+        }
 
         bool success = propagate(efficientTree, currentTransitionNode, heap);
-        if (success) {
+        if (success && !this->bounds.costsOnly) {
             EdgeId lastEdgeId = retrieveEdgeId(efficientTree);
             permanentTrees->addElement(efficientTree->predLabelPosition, lastEdgeId);
         }
@@ -182,12 +219,15 @@ bool MultiobjectiveSearch::buildAndAnalyze(
         NeighborhoodSize cutArcPosition,
         Node newTreeNode) {
     Node currentNode = efficientSubtree->n;
-    CostArray costCandidate = generate(MAX_COST);
+    CostArray costCandidate = add(efficientSubtree->c, cutArc.c);
+    if (pruned(costCandidate, transitionNodeForEfficientSubtree.getCardinality() + 1)) {
+        ++prunedTrees;
+        return false;
+    }
     TransitionNode& successorNode = this->getSubset(transitionNodeForEfficientSubtree, newTreeNode);
     assert(successorNode.getCardinality() == transitionNodeForEfficientSubtree.getCardinality() + 1);
-    costCandidate = add(efficientSubtree->c, cutArc.c);
 
-    if (truncatedDominance(truncated[successorNode.getIndex()], costCandidate)) {
+    if (truncatedDominance(truncated[successorNode.getIndex()], this->rounding.round(costCandidate))) {
 //    if (isDominated(this->permanentTrees[successorNode.getIndex()], costCandidate)) {
         return false;
     }
@@ -200,12 +240,64 @@ bool MultiobjectiveSearch::buildAndAnalyze(
     newOpenTree->lastTail = lastTail;
     newOpenTree->lastHead = cutArc.n;
     addNode2Sequence(efficientSubtree, *newOpenTree, newTreeNode);
-    H.push(newOpenTree);
+    OpenCosts& open{successorNode.getOpenTrees()};
+    QueueTree* queueTree = open.empty() ? nullptr : open.front();
+    if (!merge(open, newOpenTree)) {
+        this->treePool.free(newOpenTree);
+        return false;
+    }
+    ++insertions;
+    if (queueTree == nullptr) {
+        H.push(newOpenTree);
+        this->reclaimer.pushed(successorNode.getCardinality());
+    }
+    else if (open.front() == newOpenTree) {
+        H.decreaseKey(queueTree, newOpenTree);
+    }
+    clean(open, newOpenTree);
     return true;
 //        printf("\t\tNew open tree: %lu, c=(%u, %u, %u)\n", newOpenTree->n, newOpenTree->c[0],  newOpenTree->c[1],  newOpenTree->c[2]);
     //newOpenTree.lastArcOriented = orientedArc;
 }
 
+bool MultiobjectiveSearch::merge(OpenCosts& open, QueueTree* newLabel) {
+    const CostArray roundedNew = this->rounding.round(newLabel->c);
+    auto it = open.begin();
+    while (it != open.end() && !lexSmaller(newLabel->c, (*it)->c)) {
+        if (dominates(this->rounding.round((*it)->c), roundedNew)) {
+            return false;
+        }
+        ++it;
+    }
+    open.insert(it, newLabel);
+    return true;
+}
+
+void MultiobjectiveSearch::clean(OpenCosts& open, QueueTree* newLabel) {
+    const CostArray roundedNew = this->rounding.round(newLabel->c);
+    auto it = std::find(open.begin(), open.end(), newLabel);
+    assert(it != open.end());
+    ++it;
+    //Only the first open tree is in the heap and it is not after newLabel.
+    while (it != open.end()) {
+        if (dominates(roundedNew, this->rounding.round((*it)->c))) {
+            assert(!(*it)->inQueue);
+            this->treePool.free(*it);
+            it = open.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void MultiobjectiveSearch::releaseTransitionNode(long unsigned index) {
+    assert(this->implicitNodes[index] != nullptr && this->implicitNodes[index]->getOpenTrees().empty());
+    ++this->releasedTransitionNodes;
+    this->implicitNodes[index].reset();
+    this->truncated.erase(index);
+}
+
 bool MultiobjectiveSearch::propagate(QueueTree* efficientTree, const TransitionNode& transitionNode, BinaryHeap<QueueTree, BN::CandidateLexComp>& H) {
     NeighborhoodSize lastCutArcPosition = efficientTree->lastEdgeId;
     const Neighborhood& lastTailNeighborhood{this->G.node(efficientTree->lastTail).adjacentArcs};
@@ -251,17 +343,20 @@ bool MultiobjectiveSearch::propagate(QueueTree* efficientTree, const TransitionN
 }
 
 void MultiobjectiveSearch::storeStatistics(Solution &sol) {
-    sol.trees = sol.spanningTreeIndices.size();
+    sol.trees = sol.front.size();
     sol.insertions = insertions;
     sol.extractions = extractions;
     sol.nqtIt = nqtIterations;
     sol.transitionArcsCount = 0;
     sol.transitionNodes = countTransitionNodes();
+    sol.prunedTrees = prunedTrees;
+    //Only the chains of the efficient trees are needed after the search.
+    this->permanentTrees->compact(sol.spanningTreeIndices, this->G.nodesCount - 1);
     sol.permanents = std::move(this->permanentTrees);
 }
 
 size_t MultiobjectiveSearch::countTransitionNodes() const {
-    return std::count_if(this->implicitNodes.begin(), this->implicitNodes.end(), [](const std::unique_ptr<TransitionNode>& i){return i.get() !=
+    return this->releasedTransitionNodes + std::count_if(this->implicitNodes.begin(), this->implicitNodes.end(), [](const std::unique_ptr<TransitionNode>& i){return i.get() !=
                                                                                                                                      nullptr;});
 }
 
@@ -0,0 +1,191 @@
+#include <cassert>
+#include <numeric>
+
+#include "../includes/BlockDecomposition.h"
+
+using namespace std;
+
+namespace {
+    //Tarjan's search for biconnected components. Tree and back edges are stacked and popped once an articulation
+    //point (or the root) closes a block.
+    struct BlockFinder {
+        explicit BlockFinder(const Graph& G):
+                G{G}, discovery(G.nodesCount, 0), low(G.nodesCount, 0), edge2Block(G.edges.size(), INVALID_ARC) {}
+
+        void search(Node u, EdgeId parentEdge) {
+            discovery[u] = low[u] = ++time;
+            for (const Arc& a : G.adjacentArcs(u)) {
+                if (a.idInEdgesVector == parentEdge) {
+                    continue;
+                }
+                if (discovery[a.n] == 0) {
+                    edgeStack.push_back(a.idInEdgesVector);
+                    search(a.n, a.idInEdgesVector);
+                    low[u] = min(low[u], low[a.n]);
+                    if (low[a.n] >= discovery[u]) {
+                        EdgeId e;
+                        do {
+                            e = edgeStack.back();
+                            edgeStack.pop_back();
+                            edge2Block[e] = blocksCount;
+                        } while (e != a.idInEdgesVector);
+                        ++blocksCount;
+                    }
+                }
+                else if (discovery[a.n] < discovery[u]) {
+                    low[u] = min(low[u], discovery[a.n]);
+                    edgeStack.push_back(a.idInEdgesVector);
+                }
+            }
+        }
+
+        const Graph& G;
+        vector<size_t> discovery;
+        vector<size_t> low;
+        vector<EdgeId> edgeStack;
+        vector<EdgeId> edge2Block;
+        EdgeId blocksCount{0};
+        size_t time{0};
+    };
+}
+
+vector<Block> decompose(const Graph& G) {
+    BlockFinder finder(G);
+    for (Node u = 0; u < G.nodesCount; ++u) {
+        if (finder.discovery[u] == 0) {
+            finder.search(u, INVALID_ARC);
+        }
+    }
+    vector<Block> blocks(finder.blocksCount);
+    vector<Node> node2LocalNode(G.nodesCount, INVALID_NODE);
+    vector<EdgeId> edge2LocalEdge(G.edges.size(), INVALID_ARC);
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        Block& block{blocks[b]};
+        vector<Node> blockNodes;
+        for (const Edge& edge : G.edges) {
+            if (finder.edge2Block[edge.id] != b) {
+                continue;
+            }
+            edge2LocalEdge[edge.id] = block.blockEdgeIds2EdgeIds.size();
+            block.blockEdgeIds2EdgeIds.push_back(edge.id);
+            blockNodes.push_back(edge.tail);
+            blockNodes.push_back(edge.head);
+        }
+        sort(blockNodes.begin(), blockNodes.end());
+        blockNodes.erase(unique(blockNodes.begin(), blockNodes.end()), blockNodes.end());
+        for (Node localId = 0; localId < blockNodes.size(); ++localId) {
+            node2LocalNode[blockNodes[localId]] = localId;
+            block.graph.addNode(localId);
+        }
+        for (EdgeId originalId : block.blockEdgeIds2EdgeIds) {
+            const Edge& edge{G.edges[originalId]};
+            block.graph.edges.emplace_back(edge2LocalEdge[originalId], node2LocalNode[edge.tail], node2LocalNode[edge.head], edge.c);
+            block.graph.arcsCount++;
+        }
+        //Adjacency lists are filled following the order of the adjacency lists in G.
+        for (Node localId = 0; localId < blockNodes.size(); ++localId) {
+            for (const Arc& a : G.adjacentArcs(blockNodes[localId])) {
+                if (finder.edge2Block[a.idInEdgesVector] == b) {
+                    block.graph.adjacentArcs(localId).emplace_back(node2LocalNode[a.n], a.c, edge2LocalEdge[a.idInEdgesVector]);
+                }
+            }
+        }
+    }
+    return blocks;
+}
+
+vector<SumEntry> minkowskiSum(const vector<CostArray>& lhs, const vector<CostArray>& rhs) {
+    vector<SumEntry> candidates;
+    candidates.reserve(lhs.size() * rhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        for (size_t j = 0; j < rhs.size(); ++j) {
+            candidates.push_back({add(lhs[i], rhs[j]), i, j});
+        }
+    }
+    sort(candidates.begin(), candidates.end(),
+         [](const SumEntry& a, const SumEntry& b) { return lexSmaller(a.c, b.c); });
+    //In lexicographic order, a sum can only be dominated by sums that were processed before it. Hence, checking
+    //against the truncated front of the kept sums suffices.
+    vector<SumEntry> result;
+    TruncatedFront front;
+    for (const SumEntry& candidate : candidates) {
+        if (truncatedDominance(front, candidate.c)) {
+            continue;
+        }
+        truncatedInsertion(front, candidate.c);
+        result.push_back(candidate);
+    }
+    return result;
+}
+
+Solution combineBlockSolutions(const vector<Block>& blocks, vector<Solution>& blockSolutions,
+                               const Preprocessor& bounds) {
+    assert(blocks.size() == blockSolutions.size());
+    Solution solution;
+    solution.trees = 0;
+    //Decode the trees of every block and translate their edges to the ids in the decomposed graph.
+    vector<vector<vector<EdgeId>>> blockTrees(blocks.size());
+    vector<vector<CostArray>> blockFronts(blocks.size());
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const Block& block{blocks[b]};
+        Solution& blockSolution{blockSolutions[b]};
+        for (size_t treeIndex : blockSolution.spanningTreeIndices) {
+            vector<EdgeId> edges = blockSolution.getEdges(treeIndex, block.graph.nodesCount - 1);
+            for (EdgeId& edgeId : edges) {
+                edgeId = block.blockEdgeIds2EdgeIds[edgeId];
+            }
+            blockTrees[b].push_back(move(edges));
+        }
+        blockFronts[b] = move(blockSolution.front);
+        solution.extractions += blockSolution.extractions;
+        solution.insertions += blockSolution.insertions;
+        solution.nqtIt += blockSolution.nqtIt;
+        solution.transitionArcsCount += blockSolution.transitionArcsCount;
+        solution.transitionNodes += blockSolution.transitionNodes;
+        solution.transitionArcs += blockSolution.transitionArcs;
+        solution.prunedTrees += blockSolution.prunedTrees;
+        blockSolution.permanents.reset();
+    }
+    //Fold the fronts starting with the smallest ones to keep the intermediate sums small.
+    vector<size_t> order(blocks.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&blockFronts](size_t a, size_t b) { return blockFronts[a].size() < blockFronts[b].size(); });
+    vector<vector<SumEntry>> partialSums;
+    vector<CostArray> partialFront = blockFronts[order[0]];
+    for (size_t i = 1; i < order.size(); ++i) {
+        partialSums.push_back(minkowskiSum(partialFront, blockFronts[order[i]]));
+        //Costs are non-negative, so sums exceeding the budget cannot become feasible by adding further blocks.
+        vector<SumEntry>& sums{partialSums.back()};
+        sums.erase(remove_if(sums.begin(), sums.end(),
+                             [&bounds](const SumEntry& entry) { return !bounds.withinBudget(entry.c); }),
+                   sums.end());
+        partialFront.clear();
+        for (const SumEntry& entry : partialSums.back()) {
+            partialFront.push_back(entry.c);
+        }
+    }
+    for (const SumEntry& entry : partialSums.back()) {
+        solution.front.push_back(entry.c);
+    }
+    if (bounds.costsOnly) {
+        solution.trees = solution.front.size();
+        return solution;
+    }
+    //Walk back through the partial sums to collect the block trees forming every efficient tree.
+    for (size_t position = 0; position < partialSums.back().size(); ++position) {
+        vector<EdgeId> edges;
+        size_t current = position;
+        for (size_t level = partialSums.size(); level-- > 0;) {
+            const SumEntry& entry{partialSums[level][current]};
+            const vector<EdgeId>& blockEdges{blockTrees[order[level + 1]][entry.rhsPosition]};
+            edges.insert(edges.end(), blockEdges.begin(), blockEdges.end());
+            current = entry.lhsPosition;
+        }
+        const vector<EdgeId>& firstBlockEdges{blockTrees[order[0]][current]};
+        edges.insert(edges.end(), firstBlockEdges.begin(), firstBlockEdges.end());
+        solution.addSpanningTree(edges);
+    }
+    solution.trees = solution.front.size();
+    return solution;
+}
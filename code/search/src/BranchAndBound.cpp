@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "../../datastructures/includes/graph.h"
+#include "../../datastructures/includes/Parallel.h"
+#include "../../preprocessing/includes/Preprocessor.h"
+
+#include "../includes/BranchAndBound.h"
+
+using namespace BranchAndBound;
+
+void SearchRegion::insert(const CostArray& f) {
+    //The boxes that contain f are split into one box per objective in which f bounds the costs from above.
+    std::vector<CostArray> candidates;
+    auto split = std::partition(this->upperBounds.begin(), this->upperBounds.end(), [&f](const CostArray& u) {
+        return !weakDominates(f, u);
+    });
+    for (auto it = split; it != this->upperBounds.end(); ++it) {
+        for (Dimension j = 0; j < DIM; ++j) {
+            CostArray candidate{*it};
+            candidate[j] = f[j];
+            candidates.push_back(candidate);
+        }
+    }
+    this->upperBounds.erase(split, this->upperBounds.end());
+    //Only the maximal candidates are local upper bounds, the boxes of the others are contained in them.
+    const size_t kept{this->upperBounds.size()};
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        bool redundant{false};
+        for (size_t k = 0; k < candidates.size() && !redundant; ++k) {
+            redundant = k != i && dominates(candidates[i], candidates[k]) && (candidates[i] != candidates[k] || k < i);
+        }
+        for (size_t k = 0; k < kept && !redundant; ++k) {
+            redundant = dominates(candidates[i], this->upperBounds[k]);
+        }
+        if (!redundant) {
+            this->upperBounds.push_back(candidates[i]);
+        }
+    }
+}
+
+bool SearchRegion::excludes(const CostArray& ideal, const std::vector<Info<CostType>>& weights,
+                            const std::vector<uint64_t>& values) const {
+    for (const CostArray& u : this->upperBounds) {
+        if (!weakDominates(ideal, u)) {
+            continue;
+        }
+        bool empty{false};
+        for (size_t j = 0; j < weights.size() && !empty; ++j) {
+            //The largest weighted sum of an integer cost vector in the box.
+            uint64_t maximum{0};
+            for (Dimension i = 0; i < DIM; ++i) {
+                maximum += static_cast<uint64_t>(weights[j][i]) * (u[i] - 1);
+            }
+            empty = maximum < values[j];
+        }
+        if (!empty) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BranchAndBoundSearch::BranchAndBoundSearch(const Graph& G, const Preprocessor& preprocessor):
+        graph{G},
+        bounds{preprocessor},
+        //Every tree is rounded once, so the rounding may use the full approximation factor.
+        rounding(preprocessor.epsilon, 1),
+        weights(weightedSumWeights(BOUND_WEIGHTS_RESOLUTION)) {
+    std::vector<EdgeId> edgeIds;
+    for (EdgeId id = 0; id < this->graph.edges.size(); ++id) {
+        if (!this->graph.edges[id].isRed) {
+            edgeIds.push_back(id);
+        }
+    }
+    for (size_t j = 0; j < this->weights.size(); ++j) {
+        const Info<CostType>& w{this->weights[j]};
+        for (Dimension i = 0; i < DIM; ++i) {
+            if (w[i] == BOUND_WEIGHTS_RESOLUTION) {
+                this->unitWeights[i] = j;
+            }
+        }
+        std::vector<uint64_t> keys(this->graph.edges.size());
+        for (EdgeId id : edgeIds) {
+            for (Dimension i = 0; i < DIM; ++i) {
+                keys[id] += static_cast<uint64_t>(w[i]) * this->graph.edges[id].c[i];
+            }
+        }
+        this->orders.push_back(edgeIds);
+        std::stable_sort(this->orders.back().begin(), this->orders.back().end(), [&G, &keys](EdgeId lhs, EdgeId rhs) {
+            return keys[lhs] < keys[rhs] || (keys[lhs] == keys[rhs] && lexSmaller(G.edges[lhs].c, G.edges[rhs].c));
+        });
+    }
+}
+
+void BranchAndBoundSearch::insert(const CostArray& c, const std::vector<EdgeId>& edges) {
+    if (!this->bounds.withinBudget(c)) {
+        return;
+    }
+    const CostArray rounded = this->rounding.round(c);
+    std::unique_lock<std::shared_timed_mutex> lock(this->frontMutex);
+    if (!this->region.contains(rounded)) {
+        return;
+    }
+    this->front.erase(std::remove_if(this->front.begin(), this->front.end(), [&rounded](const RoundedTree& tree) {
+        return dominates(rounded, tree.rounded);
+    }), this->front.end());
+    this->front.push_back(RoundedTree{c, rounded, edges});
+    this->region.insert(rounded);
+    ++this->insertions;
+}
+
+bool BranchAndBoundSearch::fathomed(const Worker& worker) {
+    if (!this->bounds.withinBudget(worker.ideal)) {
+        return true;
+    }
+    //The trees behind the dominance bound and the upper bound set are not necessarily part of an approximated front.
+    if (this->rounding.exact && (weakDominates(this->bounds.dominanceBound, worker.ideal) ||
+                                 this->bounds.upperBoundDominance(worker.ideal))) {
+        return true;
+    }
+    std::shared_lock<std::shared_timed_mutex> lock(this->frontMutex);
+    if (!this->rounding.exact) {
+        //The rounding is monotone, so no tree of the subproblem has rounded costs inside the region if its rounded
+        //ideal point is outside. The weighted sums of the lower bound set do not carry over to the rounded costs.
+        return !this->region.contains(this->rounding.round(worker.ideal));
+    }
+    return this->region.excludes(worker.ideal, this->weights, worker.values);
+}
+
+EdgeId BranchAndBoundSearch::bound(Worker& worker, const Subproblem& subproblem) {
+    ++worker.subproblems;
+    for (size_t j = 0; j < this->weights.size(); ++j) {
+        std::vector<EdgeId>& tree{worker.trees[j]};
+        CostArray& c{worker.treeCosts[j]};
+        tree.clear();
+        c = generate(0);
+        worker.sets.reset();
+        for (size_t id = subproblem.forced.find_first(); id != boost::dynamic_bitset<>::npos;
+             id = subproblem.forced.find_next(id)) {
+            const Edge& edge{this->graph.edges[id]};
+            worker.sets.unite(edge.tail, edge.head);
+            tree.push_back(id);
+            addInPlace(c, edge.c);
+        }
+        for (EdgeId id : this->orders[j]) {
+            if (tree.size() + 1 == this->graph.nodesCount) {
+                break;
+            }
+            const Edge& edge{this->graph.edges[id]};
+            if (!subproblem.excluded[id] && worker.sets.unite(edge.tail, edge.head)) {
+                tree.push_back(id);
+                addInPlace(c, edge.c);
+            }
+        }
+        if (tree.size() + 1 != this->graph.nodesCount) {
+            return INVALID_ARC;
+        }
+        worker.values[j] = 0;
+        for (Dimension i = 0; i < DIM; ++i) {
+            worker.values[j] += static_cast<uint64_t>(this->weights[j][i]) * c[i];
+        }
+    }
+    for (Dimension i = 0; i < DIM; ++i) {
+        worker.ideal[i] = worker.treeCosts[this->unitWeights[i]][i];
+    }
+    for (size_t j = 0; j < this->weights.size(); ++j) {
+        this->insert(worker.treeCosts[j], worker.trees[j]);
+    }
+    if (this->fathomed(worker)) {
+        ++worker.fathomed;
+        return INVALID_ARC;
+    }
+    for (const CostArray& c : worker.treeCosts) {
+        if (c == worker.ideal) {
+            return INVALID_ARC;
+        }
+    }
+    //Branch on the edge on which the MSTs disagree the most.
+    for (const std::vector<EdgeId>& tree : worker.trees) {
+        for (EdgeId id : tree) {
+            ++worker.occurrences[id];
+        }
+    }
+    EdgeId branchingEdge{INVALID_ARC};
+    size_t bestBalance{this->weights.size()};
+    for (const std::vector<EdgeId>& tree : worker.trees) {
+        for (EdgeId id : tree) {
+            const size_t count{worker.occurrences[id]};
+            const size_t balance{count * 2 > this->weights.size() ? count * 2 - this->weights.size() :
+                                 this->weights.size() - count * 2};
+            if (count < this->weights.size() && balance < bestBalance) {
+                bestBalance = balance;
+                branchingEdge = id;
+            }
+        }
+    }
+    for (const std::vector<EdgeId>& tree : worker.trees) {
+        for (EdgeId id : tree) {
+            worker.occurrences[id] = 0;
+        }
+    }
+    assert(branchingEdge != INVALID_ARC && !subproblem.forced[branchingEdge]);
+    return branchingEdge;
+}
+
+bool BranchAndBoundSearch::limitReached(size_t subproblems) {
+    if (this->stopped) {
+        return true;
+    }
+    if (this->anytime.deadline > 0 && this->anytime.limitReached(0, subproblems, this->start)) {
+        this->stopped = true;
+    }
+    return this->stopped;
+}
+
+void BranchAndBoundSearch::explore(Worker& worker, Subproblem& subproblem) {
+    if (this->limitReached(worker.subproblems)) {
+        return;
+    }
+    EdgeId branchingEdge = this->bound(worker, subproblem);
+    if (branchingEdge == INVALID_ARC) {
+        return;
+    }
+    subproblem.forced[branchingEdge] = true;
+    this->explore(worker, subproblem);
+    subproblem.forced[branchingEdge] = false;
+    subproblem.excluded[branchingEdge] = true;
+    this->explore(worker, subproblem);
+    subproblem.excluded[branchingEdge] = false;
+}
+
+Solution BranchAndBoundSearch::run() {
+    if (this->graph.arcsCount == 0) {
+        return Solution();
+    }
+    Solution solution;
+    this->start = std::chrono::high_resolution_clock::now();
+    if (!collectSupportedTrees(this->graph, [this](const CostArray& c, const std::vector<EdgeId>& edges) {
+        this->insert(c, edges);
+    })) {
+        solution.trees = 0;
+        return solution;
+    }
+
+    //Expand the first levels of the search tree breadth first until every thread gets several subproblems.
+    size_t threadsCount = hardwareThreads();
+    std::vector<Worker> workers(threadsCount, Worker(this->graph.nodesCount, this->graph.edges.size(),
+                                                     this->weights.size()));
+    std::deque<Subproblem> open(1);
+    open.front().forced.resize(this->graph.edges.size());
+    open.front().excluded.resize(this->graph.edges.size());
+    while (threadsCount > 1 && !open.empty() && open.size() < 8 * threadsCount) {
+        Subproblem subproblem{std::move(open.front())};
+        open.pop_front();
+        EdgeId branchingEdge = this->bound(workers.front(), subproblem);
+        if (branchingEdge == INVALID_ARC) {
+            continue;
+        }
+        open.push_back(subproblem);
+        open.back().forced[branchingEdge] = true;
+        open.push_back(std::move(subproblem));
+        open.back().excluded[branchingEdge] = true;
+    }
+    inParallelPerThread(open.size(), [this, &open, &workers](size_t thread, size_t i) {
+        this->explore(workers[thread], open[i]);
+    });
+    solution.complete = !this->stopped;
+
+    emitFront(this->front, this->anytime, this->bounds.costsOnly, solution);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - this->start;
+    solution.time = duration.count();
+    solution.insertions = this->insertions;
+    for (const Worker& worker : workers) {
+        solution.extractions += worker.subproblems;
+        solution.prunedTrees += worker.fathomed;
+    }
+    return solution;
+}
@@ -21,12 +21,15 @@ inline static boost::dynamic_bitset<> addNode(const boost::dynamic_bitset<>& exi
     return n;
 }
 
-IGMDA::IGMDA(const Graph &G):
+IGMDA::IGMDA(const Graph &G, const Preprocessor& preprocessor):
         graph{G},
         permanentTrees(std::make_unique<Permanents>()),
         implicitNodes((1UL<<(this->graph.nodesCount - 1))),
-        dominanceBound(generate(MAX_COST)),
+        bounds{preprocessor},
+        rounding(preprocessor.epsilon, G.nodesCount - 1),
+        dominanceBound(preprocessor.dominanceBound),
         targetNode{(1UL<<(this->graph.nodesCount - 1)) - 1},
+        reclaimer(G.nodesCount),
         extractions{0},
         insertions{0},
         nqtIterations{0} {
@@ -34,8 +37,23 @@ IGMDA::IGMDA(const Graph &G):
                 printf("Graph is too big. Leads to overflow computing target implicit node id. Abort\n");
                 exit(1);
             }
+            assert(bounds.lb.size() == graph.nodesCount);
         }
 
+bool IGMDA::pruned(const CostArray& c, const CostArray& lowerBound) const {
+    const CostArray bound = add(c, lowerBound);
+    if (truncatedDominance(*this->targetFront, this->rounding.round(bound))) {
+        return true;
+    }
+    //The trees behind the dominance bound and the upper bound set are not necessarily part of an approximated
+    //front. Pruning with them would break the approximation guarantee.
+    if (!this->bounds.withinBudget(bound)) {
+        return true;
+    }
+    return this->rounding.exact &&
+           (weakDominates(this->dominanceBound, bound) || this->bounds.upperBoundDominance(bound));
+}
+
 //Since we are representing subsets of n nodes using only 2^(n-1) subsets, we first need to multiply by 2 to get
 //the correct index of the predSubset in the 2^n cardinality set. Then, we set the bit for the new node using "|1UL<<newNode".
 //The bitset for the new subset of nodes is now finished. We just need to translate it back to our index-set with
@@ -50,8 +68,9 @@ IGMDA::TransitionNode& IGMDA::initTransitionNode(
         const TransitionNode& predSubset,
         Node newNode) {
     std::unique_ptr<TransitionNode> newTransitionNode =
-            std::make_unique<TransitionNode>(this->graph, std::move(bitRepresentation), decimalRepresentation, predSubset.outgoingArcs(), newNode);
+            std::make_unique<TransitionNode>(std::move(bitRepresentation), decimalRepresentation, predSubset.outgoingArcs(), newNode);
     long unsigned index = newTransitionNode->getIndex();
+    this->reclaimer.created(newTransitionNode->getCardinality(), index);
     this->implicitNodes[index] = std::move(newTransitionNode);
     return *this->implicitNodes[index];
 }
@@ -60,7 +79,8 @@ IGMDA::TransitionNode& IGMDA::getTransitionNode(const TransitionNode& predSubset
     if (this->implicitNodes[decimalRepresentation].get() == nullptr) {
         boost::dynamic_bitset<> bitRepresentation = addNode(predSubset.getNodes(), newNode);
         TransitionNode& result = this->initTransitionNode(std::move(bitRepresentation), decimalRepresentation, predSubset, newNode);
-        this->transitionArcs += result.outgoingArcs().size();
+        //The subset specific bound is only computed once, when the transition node is reached for the first time.
+        result.setLowerBound(this->bounds.subsetLowerBound(result.getNodes()));
         return result;
     }
     else {
@@ -75,35 +95,63 @@ Solution IGMDA::run() {
     Pool<SubTree> treesPool;
     SubTree* initialTree = treesPool.newItem();
     initialTree->n = 0; initialTree->c = generate(0);
-    std::unique_ptr<TransitionNode> initialImplicitNode = std::make_unique<TransitionNode>(this->graph, 0);
+    std::unique_ptr<TransitionNode> initialImplicitNode = std::make_unique<TransitionNode>(this->graph, this->bounds.edgeDominance, 0);
     initialImplicitNode->setQueueTree(initialTree);
+    initialImplicitNode->setLowerBound(this->bounds.subsetLowerBound(initialImplicitNode->getNodes()));
+    this->reclaimer.created(1, initialImplicitNode->getIndex());
     this->implicitNodes[initialImplicitNode->getIndex()] = std::move(initialImplicitNode);
     Solution solution;
     BinaryHeap<SubTree, CandidateLexComp> heap;
     heap.push(initialTree);
-    this->truncated.emplace(targetNode, TruncatedFront());
+    this->reclaimer.pushed(1);
+    this->targetFront = &this->truncated.emplace(targetNode, TruncatedFront()).first->second;
     auto start = std::chrono::high_resolution_clock::now();
     while (heap.size() != 0) {
+        if (this->anytime.limitReached(solutionsCount, extractions, start)) {
+            solution.complete = false;
+            break;
+        }
+        this->reclaimer.releaseUnreachable(
+                [this, &treesPool](long unsigned index) { this->releaseTransitionNode(index, treesPool); });
         SubTree* minTree = heap.pop();
         extractions++;
         long unsigned currentNode = minTree->n;
-        const TransitionNode& searchNode{*this->implicitNodes[currentNode]};
+        TransitionNode& searchNode{*this->implicitNodes[currentNode]};
+        this->reclaimer.popped(searchNode.getCardinality());
         assert(searchNode.getQueueTree() == minTree);
         assert(searchNode.getIndex() == currentNode);
 
-        truncatedInsertion(truncated[currentNode], minTree->c);
+        truncatedInsertion(truncated[currentNode], this->rounding.round(minTree->c));
         nextQueueTree(minTree, heap, treesPool);
         if (currentNode == targetNode) {
+            solution.front.push_back(minTree->c);
+            ++solutionsCount;
+            if (this->bounds.costsOnly) {
+                if (this->anytime.sink) {
+                    this->anytime.sink(minTree->c, std::vector<EdgeId>());
+                }
+                continue;
+            }
             size_t solutionIndex = this->permanentTrees->getCurrentIndex();
             permanentTrees->addElement(minTree->predLabelPosition, minTree->lastEdgeId);
             assert(permanentTrees->getElement(solutionIndex).lastArc == minTree->lastEdgeId && permanentTrees->getElement(solutionIndex).predLabelPosition == minTree->predLabelPosition);
             solution.spanningTreeIndices.push_back(solutionIndex);
-            ++solutionsCount;
+            if (this->anytime.sink) {
+                this->anytime.sink(minTree->c, this->permanentTrees->getChain(solutionIndex, this->graph.nodesCount - 1));
+            }
+            continue;
+        }
+        //The target front might have grown since minTree was inserted into the heap.
+        if (pruned(minTree->c, searchNode.getLowerBound())) {
+            ++prunedTrees;
+            treesPool.free(minTree);
             continue;
         }
 
+        //The cut of a transition node is only built once a subtree spanning it survives until here.
+        this->transitionArcs += searchNode.expand(this->graph, this->bounds.edgeDominance);
         bool success = propagate(minTree, searchNode, heap, treesPool);
-        if (success) {
+        if (success && !this->bounds.costsOnly) {
             permanentTrees->addElement(minTree->predLabelPosition, minTree->lastEdgeId);
         }
         treesPool.free(minTree);
@@ -117,51 +165,29 @@ Solution IGMDA::run() {
 }
 
 void IGMDA::nextQueueTree(const SubTree* minTree, BinaryHeap<SubTree, CandidateLexComp>& heap, Pool<SubTree>& treesPool) {
-    long unsigned n{minTree->n};
-    TransitionNode& searchNode{*this->implicitNodes[n]};
-    SubTree* newQueueTree = nullptr;
-    std::vector<PredArc>& predArcs = searchNode.getIncomingArcs();
+    TransitionNode& searchNode{*this->implicitNodes[minTree->n]};
     const TruncatedFront& currentTruncatedFront{this->truncated[searchNode.getIndex()]};
-    List* minCandidates{nullptr};
-    bool success = false;
-    for (const PredArc& predInfo : predArcs) {
-        List &predSubTrees = predInfo.nextQueueTrees;
-        if (predSubTrees.empty()) {
-            continue;
+    const CostArray roundedMin = this->rounding.round(minTree->c);
+    //Dominated candidates are only discarded once they reach the top of the tournament.
+    SubTree* candidateTree = searchNode.smallestCandidate();
+    while (candidateTree != nullptr) {
+        ++nqtIterations;
+        searchNode.popSmallestCandidate();
+        const CostArray roundedCandidate = this->rounding.round(candidateTree->c);
+        if (!dominates(roundedMin, roundedCandidate) &&
+            (candidateTree->nclChecked || !truncatedDominance(currentTruncatedFront, roundedCandidate))) {
+            candidateTree->nclChecked = true;
+            heap.push(candidateTree);
+            this->reclaimer.pushed(searchNode.getCardinality());
+            searchNode.setQueueTree(candidateTree);
+            ++insertions;
+            return;
         }
-        SubTree *candidateTree = predSubTrees.first;
-        while (candidateTree != nullptr) {
-            if (newQueueTree != nullptr && !lexSmaller(candidateTree->c, newQueueTree->c)) {
-                if (dominates(newQueueTree->c, candidateTree->c) || dominates(minTree->c, candidateTree->c)) {
-                    predSubTrees.pop_front();
-                    treesPool.free(candidateTree);
-                }
-                break;
-            }
-            if (!dominates(minTree->c, candidateTree->c)) {
-                if (candidateTree->nclChecked || !truncatedDominance(currentTruncatedFront, candidateTree->c)) {
-                    candidateTree->nclChecked = true;
-                    success = true;
-                    newQueueTree = candidateTree;
-                    minCandidates = &predSubTrees;
-                    break;
-                }
-            }
-            predSubTrees.pop_front();
-            treesPool.free(candidateTree);
-            candidateTree = predSubTrees.first;
-        }
-    }
-    if (success) {
-        heap.push(newQueueTree);
-        searchNode.setQueueTree(newQueueTree);
-        ++insertions;
-        minCandidates->pop_front();
-    }
-    else{
-        //treesPool.free(searchNode.getQueueTree());
-        searchNode.setQueueTree(nullptr);
+        treesPool.free(candidateTree);
+        candidateTree = searchNode.smallestCandidate();
     }
+    //treesPool.free(searchNode.getQueueTree());
+    searchNode.setQueueTree(nullptr);
 }
 
 static SubTree* getQueueTree(ImplicitNode<SubTree>& n, Pool<SubTree>& treesPool) {
@@ -185,6 +211,8 @@ bool IGMDA::propagate(const SubTree* predLabel, const TransitionNode& searchNode
     //If the propagation yields some non-dominated subtrees, predLabel will be made permanent. predIndex indicates
     //the position in which it will be stored.
     const size_t predIndex = this->permanentTrees->getCurrentIndex();
+    //The candidates are generated one arc at a time. The cuts are short and most of the work per candidate is spent in
+    //the successor's transition node and fronts, so computing all candidate costs in one vectorized batch does not pay.
     for (const OutgoingArcInfo& outgoingArcInfo : outgoingArcs) {
         //Pruning by Chen when constructing set of outgoing edges for searchNode determined that this arc is not active.
         if (outgoingArcInfo.chenPruned || outgoingArcInfo.cutExitPruned) {
@@ -198,6 +226,7 @@ bool IGMDA::propagate(const SubTree* predLabel, const TransitionNode& searchNode
         Node newTreeNode = searchNode.getNodes()[edge.tail] ? edge.head : edge.tail;
         long unsigned successorNodeIndex = computeNewTransitionNodeIndex(searchNode.getIndex(), newTreeNode);
         costCandidate = add(predLabel->c, edge.c);
+        const CostArray roundedCandidate = this->rounding.round(costCandidate);
 
         TransitionNode& successorNode = this->getTransitionNode(searchNode, newTreeNode, successorNodeIndex);
 //        printf("\t\t\tPropagating tree with costs %u %u %u to node %lu\n",
@@ -211,71 +240,103 @@ bool IGMDA::propagate(const SubTree* predLabel, const TransitionNode& searchNode
 
         SubTree* queueTree = getQueueTree(successorNode, treesPool);
         if (queueTree->inQueue) {
-            SubTree* newLabel = treesPool.newItem();
-            newLabel->update(successorNode.getIndex(), costCandidate, outgoingArcInfo.incomingArcId, edge.id, predIndex);
-            if (lexSmaller(costCandidate, queueTree->c)) {
-                if (truncatedDominance(this->truncated[successorNode.getIndex()], costCandidate)) {
+            //The new subtree is only taken from the pool once it passed all checks.
+            const bool replacesQueueTree = lexSmaller(costCandidate, queueTree->c);
+            if (replacesQueueTree) {
+                if (truncatedDominance(this->truncated[successorNode.getIndex()], roundedCandidate)) {
                     continue;
                 }
-                success = true;
-                const PredArc& oldQueueTreePred = successorNode.getIncomingArc(queueTree->lastTransitionArc);
+            }
+            else if (dominates(this->rounding.round(queueTree->c), roundedCandidate) ) { //|| pruned(reducedCosts)) {
+                continue;
+            }
+            //Bound based pruning is only tried on candidates that survive the cheaper local dominance checks.
+            if (pruned(costCandidate, successorNode.getLowerBound())) {
+                ++prunedTrees;
+                continue;
+            }
+            success = true;
+            SubTree* newLabel = treesPool.newItem();
+            newLabel->update(successorNode.getIndex(), costCandidate, outgoingArcInfo.incomingArcId, aId, predIndex);
+            if (replacesQueueTree) {
                 //printf("\n\nSubstitute (%u, %u) with (%u, %u) for index %lu\n", queueTree.c[0], queueTree.c[1], cr1, cr2, queueTree.n);
                 H.decreaseKey(queueTree, newLabel);
                 successorNode.setQueueTree(newLabel);
-                oldQueueTreePred.nextQueueTrees.push_front(queueTree);
+                successorNode.pushCandidateFront(queueTree->lastTransitionArc, queueTree);
             } else {
-                if (dominates(queueTree->c, costCandidate) ) { //|| pruned(reducedCosts)) {
-                    continue;
-                }
 //                printf("\t\t\t\tThe queue tree is in queue and is %u %u %u, stays!\n",
 //                       queueTree->c[0], queueTree->c[1], queueTree->c[2]);
-                success = true;
-                const PredArc& predArc = successorNode.getIncomingArc(newLabel->lastTransitionArc);
-                predArc.nextQueueTrees.push_back(newLabel);
+                successorNode.pushCandidateBack(newLabel->lastTransitionArc, newLabel);
             }
         }
         else {
-            if (truncatedDominance(this->truncated[successorNode.getIndex()], costCandidate)) {
+            if (truncatedDominance(this->truncated[successorNode.getIndex()], roundedCandidate)) {
+                continue;
+            }
+            if (pruned(costCandidate, successorNode.getLowerBound())) {
+                ++prunedTrees;
                 continue;
             }
             success = true;
-            queueTree->update(successorNode.getIndex(), costCandidate, outgoingArcInfo.incomingArcId, edge.id, predIndex);
+            queueTree->update(successorNode.getIndex(), costCandidate, outgoingArcInfo.incomingArcId, aId, predIndex);
 //            printf("\t\t\t\tNo queue tree and is %u %u %u, I'm queue!\n",
 //                   queueTree->c[0], queueTree->c[1], queueTree->c[2]);
             assert(queueTree->n == successorNode.getIndex());
             //printf("\n\nPushing (%u, %u) for index %lu\n", cr1, cr2, queueTree.n);
             H.push(queueTree);
+            this->reclaimer.pushed(successorNode.getCardinality());
         }
     }
     return success;
 }
 
+static size_t activeTransitionArcs(const ImplicitNode<SubTree>& transitionNode) {
+    if (!transitionNode.initialized()) {
+        return 0;
+    }
+    return std::count_if(transitionNode.outgoingArcs().begin(), transitionNode.outgoingArcs().end(),
+                         [](const OutgoingArcInfo& arcInfo) { return !arcInfo.chenPruned && !arcInfo.cutExitPruned; });
+}
+
+void IGMDA::releaseTransitionNode(long unsigned index, Pool<SubTree>& treesPool) {
+    std::unique_ptr<TransitionNode>& transitionNode{this->implicitNodes[index]};
+    assert(transitionNode != nullptr);
+    //A queue tree that is not in the heap was created for a candidate that got pruned afterwards.
+    SubTree* queueTree = transitionNode->getQueueTree();
+    if (queueTree != nullptr) {
+        assert(!queueTree->inQueue);
+        treesPool.free(queueTree);
+    }
+    ++this->releasedTransitionNodes;
+    this->releasedTransitionArcs += activeTransitionArcs(*transitionNode);
+    transitionNode.reset();
+    this->truncated.erase(index);
+}
+
 void IGMDA::storeStatistics(Solution &sol) {
-    sol.trees = sol.spanningTreeIndices.size();
+    sol.trees = sol.front.size();
     sol.insertions = insertions;
     sol.extractions = extractions;
     sol.nqtIt = nqtIterations;
     sol.transitionArcsCount = this->transitionArcs;
     sol.transitionNodes = countTransitionNodes();
     sol.transitionArcs = countTransitionArcs();
+    sol.prunedTrees = prunedTrees;
+    //Only the chains of the efficient trees are needed after the search.
+    this->permanentTrees->compact(sol.spanningTreeIndices, this->graph.nodesCount - 1);
     sol.permanents = std::move(this->permanentTrees);
 }
 
 size_t IGMDA::countTransitionNodes() const {
-    return std::count_if(this->implicitNodes.begin(), this->implicitNodes.end(), [](const std::unique_ptr<TransitionNode>& i){return i.get() !=
+    return this->releasedTransitionNodes + std::count_if(this->implicitNodes.begin(), this->implicitNodes.end(), [](const std::unique_ptr<TransitionNode>& i){return i.get() !=
             nullptr;});
 }
 
 size_t IGMDA::countTransitionArcs() const {
-    size_t counter{0};
+    size_t counter{this->releasedTransitionArcs};
     for (auto& transitionNode : this->implicitNodes) {
-        if (transitionNode == nullptr) {
-            continue;
-        }
-        for (const auto& arcInfo : transitionNode->outgoingArcs()) {
-            if (!arcInfo.chenPruned && !arcInfo.cutExitPruned) {
-                ++counter;
-            }
+        if (transitionNode != nullptr) {
+            counter += activeTransitionArcs(*transitionNode);
         }
     }
     return counter;
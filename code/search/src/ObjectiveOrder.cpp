@@ -0,0 +1,61 @@
+#include <cmath>
+
+#include "../includes/ObjectiveOrder.h"
+
+using namespace std;
+
+namespace {
+    //Pearson correlation of the costs of the edges of G in the objectives i and j.
+    double correlation(const Graph& G, Dimension i, Dimension j) {
+        double meanI{0}, meanJ{0};
+        for (const Edge& edge : G.edges) {
+            meanI += edge.c[i];
+            meanJ += edge.c[j];
+        }
+        meanI /= G.edges.size();
+        meanJ /= G.edges.size();
+        double covariance{0}, varianceI{0}, varianceJ{0};
+        for (const Edge& edge : G.edges) {
+            covariance += (edge.c[i] - meanI) * (edge.c[j] - meanJ);
+            varianceI += (edge.c[i] - meanI) * (edge.c[i] - meanI);
+            varianceJ += (edge.c[j] - meanJ) * (edge.c[j] - meanJ);
+        }
+        if (varianceI == 0 || varianceJ == 0) {
+            return 1;
+        }
+        return covariance / sqrt(varianceI * varianceJ);
+    }
+}
+
+vector<DimensionsVector> rankObjectiveOrders(const Graph& G) {
+    vector<DimensionsVector> orders;
+    vector<double> scores;
+    for (Dimension primary = 0; primary < DIM; ++primary) {
+        DimensionsVector order;
+        order[0] = primary;
+        Dimension position{1};
+        for (Dimension i = 0; i < DIM; ++i) {
+            if (i != primary) {
+                order[position++] = i;
+            }
+        }
+        double score{0};
+        size_t pairs{0};
+        for (Dimension i = 1; i < DIM; ++i) {
+            for (Dimension j = i + 1; j < DIM; ++j) {
+                score += correlation(G, order[i], order[j]);
+                ++pairs;
+            }
+        }
+        orders.push_back(order);
+        scores.push_back(pairs > 0 ? score / pairs : 0);
+    }
+    vector<size_t> ranking(DIM);
+    iota(ranking.begin(), ranking.end(), 0);
+    stable_sort(ranking.begin(), ranking.end(), [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+    vector<DimensionsVector> rankedOrders;
+    for (size_t position : ranking) {
+        rankedOrders.push_back(orders[position]);
+    }
+    return rankedOrders;
+}
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <chrono>
+
+#include "../../datastructures/includes/graph.h"
+#include "../../preprocessing/includes/Preprocessor.h"
+
+#include "../includes/Ranking.h"
+
+using namespace Ranking;
+
+SpanningTreeRanking::SpanningTreeRanking(const Graph& G, const Info<CostType>& weights):
+        graph{G},
+        weights{weights},
+        treeParent(G.nodesCount),
+        treeParentEdge(G.nodesCount),
+        depth(G.nodesCount),
+        treeAdjacency(G.nodesCount) {
+    for (EdgeId id = 0; id < this->graph.edges.size(); ++id) {
+        if (!this->graph.edges[id].isRed) {
+            this->order.push_back(id);
+        }
+    }
+    std::vector<uint64_t> keys(this->graph.edges.size());
+    for (EdgeId id : this->order) {
+        keys[id] = this->weightedCosts(this->graph.edges[id].c);
+    }
+    std::stable_sort(this->order.begin(), this->order.end(), [this, &keys](EdgeId lhs, EdgeId rhs) {
+        return keys[lhs] < keys[rhs] ||
+               (keys[lhs] == keys[rhs] && lexSmaller(this->graph.edges[lhs].c, this->graph.edges[rhs].c));
+    });
+}
+
+uint64_t SpanningTreeRanking::weightedCosts(const CostArray& c) const {
+    uint64_t sum{0};
+    for (Dimension i = 0; i < DIM; ++i) {
+        sum += static_cast<uint64_t>(this->weights[i]) * c[i];
+    }
+    return sum;
+}
+
+bool SpanningTreeRanking::findBestSwap(Subproblem& subproblem) {
+    //Root the tree at node 0.
+    for (auto& neighbors : this->treeAdjacency) {
+        neighbors.clear();
+    }
+    boost::dynamic_bitset<> inTree(this->graph.edges.size());
+    uint64_t heaviestSwappable{0};
+    for (EdgeId id : subproblem.mst) {
+        const Edge& edge{this->graph.edges[id]};
+        this->treeAdjacency[edge.tail].emplace_back(edge.head, id);
+        this->treeAdjacency[edge.head].emplace_back(edge.tail, id);
+        inTree[id] = true;
+        if (!subproblem.forced[id]) {
+            heaviestSwappable = std::max(heaviestSwappable, this->weightedCosts(edge.c));
+        }
+    }
+    this->treeParent[0] = INVALID_NODE;
+    this->depth[0] = 0;
+    this->stack.assign(1, 0);
+    while (!this->stack.empty()) {
+        Node u = this->stack.back();
+        this->stack.pop_back();
+        for (const auto& neighbor : this->treeAdjacency[u]) {
+            if (neighbor.first != this->treeParent[u]) {
+                this->treeParent[neighbor.first] = u;
+                this->treeParentEdge[neighbor.first] = neighbor.second;
+                this->depth[neighbor.first] = this->depth[u] + 1;
+                this->stack.push_back(neighbor.first);
+            }
+        }
+    }
+
+    const uint64_t treeKey{this->weightedCosts(subproblem.c)};
+    bool found{false};
+    for (EdgeId in : this->order) {
+        if (inTree[in] || subproblem.excluded[in]) {
+            continue;
+        }
+        const Edge& edge{this->graph.edges[in]};
+        const uint64_t inKey{this->weightedCosts(edge.c)};
+        //The edges are sorted by weighted costs, so no later edge yields a cheaper swap.
+        if (found && treeKey + inKey > subproblem.key + heaviestSwappable) {
+            break;
+        }
+        //Walk the cycle closed by the edge up to the lowest common ancestor of its end nodes.
+        Node u = edge.tail;
+        Node v = edge.head;
+        while (u != v) {
+            Node& deeper = this->depth[u] >= this->depth[v] ? u : v;
+            EdgeId out = this->treeParentEdge[deeper];
+            deeper = this->treeParent[deeper];
+            if (subproblem.forced[out]) {
+                continue;
+            }
+            const CostArray& outCosts{this->graph.edges[out].c};
+            //The tree is a minimum spanning tree of the subproblem, so the swap does not decrease the weighted costs.
+            const uint64_t key{treeKey - this->weightedCosts(outCosts) + inKey};
+            const CostArray next{add(substract(subproblem.c, outCosts), edge.c)};
+            if (!found || key < subproblem.key || (key == subproblem.key && lexSmaller(next, subproblem.next))) {
+                found = true;
+                subproblem.key = key;
+                subproblem.next = next;
+                subproblem.swapOut = out;
+                subproblem.swapIn = in;
+            }
+        }
+    }
+    return found;
+}
+
+void SpanningTreeRanking::insert(Subproblem&& subproblem) {
+    if (!this->findBestSwap(subproblem)) {
+        return;
+    }
+    this->heap.push_back(std::move(subproblem));
+    std::push_heap(this->heap.begin(), this->heap.end(), SubproblemComparison());
+    ++this->insertions;
+}
+
+bool SpanningTreeRanking::next() {
+    if (!this->started) {
+        this->started = true;
+        Subproblem root;
+        root.forced.resize(this->graph.edges.size());
+        root.excluded.resize(this->graph.edges.size());
+        DisjointSets sets(this->graph.nodesCount);
+        sets.reset();
+        for (EdgeId id : this->order) {
+            if (root.mst.size() + 1 == this->graph.nodesCount) {
+                break;
+            }
+            const Edge& edge{this->graph.edges[id]};
+            if (sets.unite(edge.tail, edge.head)) {
+                root.mst.push_back(id);
+                addInPlace(root.c, edge.c);
+            }
+        }
+        if (root.mst.size() + 1 != this->graph.nodesCount) {
+            return false;
+        }
+        this->currentTree = root.mst;
+        this->currentCosts = root.c;
+        this->insert(std::move(root));
+        return true;
+    }
+    if (this->heap.empty()) {
+        return false;
+    }
+    std::pop_heap(this->heap.begin(), this->heap.end(), SubproblemComparison());
+    Subproblem current{std::move(this->heap.back())};
+    this->heap.pop_back();
+    ++this->extractions;
+    //The next tree is the minimum spanning tree of the trees without swapOut. The minimum spanning tree of the
+    //extracted subproblem stays the one of the trees with swapOut.
+    Subproblem excluding;
+    excluding.mst = current.mst;
+    std::replace(excluding.mst.begin(), excluding.mst.end(), current.swapOut, current.swapIn);
+    excluding.c = current.next;
+    excluding.forced = current.forced;
+    excluding.excluded = current.excluded;
+    excluding.excluded[current.swapOut] = true;
+    this->currentTree = excluding.mst;
+    this->currentCosts = excluding.c;
+
+    Subproblem forcing;
+    forcing.mst = std::move(current.mst);
+    forcing.c = current.c;
+    forcing.forced = std::move(current.forced);
+    forcing.forced[current.swapOut] = true;
+    forcing.excluded = std::move(current.excluded);
+
+    this->insert(std::move(excluding));
+    this->insert(std::move(forcing));
+    return true;
+}
+
+Solution SpanningTreeRanking::kBest(size_t k) {
+    if (this->graph.arcsCount == 0) {
+        return Solution();
+    }
+    Solution solution;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (solution.front.size() < k && this->next()) {
+        solution.front.push_back(this->currentCosts);
+        solution.addSpanningTree(this->currentTree);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+    solution.time = duration.count();
+    solution.trees = solution.front.size();
+    solution.extractions = this->extractions;
+    solution.insertions = this->insertions;
+    return solution;
+}
+
+bool collectSupportedTrees(const Graph& G,
+                           const std::function<void(const CostArray&, const std::vector<EdgeId>&)>& insert) {
+    for (const Info<CostType>& weights : weightedSumWeights()) {
+        SpanningTreeRanking supported(G, weights);
+        if (!supported.next()) {
+            return false;
+        }
+        insert(supported.costs(), supported.edges());
+    }
+    return true;
+}
+
+void emitFront(std::vector<RoundedTree>& front, const AnytimeSettings& anytime, bool costsOnly, Solution& solution) {
+    std::sort(front.begin(), front.end(), [](const RoundedTree& lhs, const RoundedTree& rhs) {
+        return lexSmaller(lhs.c, rhs.c);
+    });
+    if (anytime.maxSolutions > 0 && front.size() > anytime.maxSolutions) {
+        front.resize(anytime.maxSolutions);
+        solution.complete = false;
+    }
+    for (const RoundedTree& tree : front) {
+        solution.front.push_back(tree.c);
+        if (!costsOnly) {
+            solution.addSpanningTree(tree.edges);
+        }
+        if (anytime.sink) {
+            anytime.sink(tree.c, costsOnly ? std::vector<EdgeId>() : tree.edges);
+        }
+    }
+    solution.trees = solution.front.size();
+}
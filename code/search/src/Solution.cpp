@@ -3,41 +3,65 @@
 #include "../../datastructures/includes/GraphCompacter.h"
 
 void Solution::printSpanningTrees(const GraphCompacter& compactGraph) {
+    for (size_t treeCount = 0; treeCount < this->front.size(); ++treeCount) {
+        printf("Solution tree number: %lu\n", treeCount);
+        if (treeCount < this->spanningTreeIndices.size()) {
+            printSpanningTree(compactGraph,
+                              this->getEdges(this->spanningTreeIndices[treeCount], compactGraph.compactGraph.nodesCount - 1));
+        }
+        else {
+            printf("\t\tTree with costs: ");
+            printCosts(add(this->front[treeCount], compactGraph.connectedComponentsCost));
+            printf("\n");
+        }
+    }
+}
 
-    size_t treeCount{0};
-    for (size_t treeIndex: this->spanningTreeIndices) {
-        printf("Solution tree number: %lu\n", treeCount++);
-        CostArray treeCosts{generate(0)};
-        PermanentTree const *tree = &this->permanents->getElement(treeIndex);
-        Edge const *preimageOfPredArc{&compactGraph.compactGraph.edges[tree->lastArc]};
-        addInPlace(treeCosts, preimageOfPredArc->c);
-        size_t printedEdges{0};
+//Prints an edge of the original graph followed by the parallel edges with the same costs that can replace it.
+static void printEdgeWithEquivalents(const GraphCompacter& compactGraph, EdgeId originalEdgeId) {
+    compactGraph.originalGraph.edges[originalEdgeId].print();
+    const std::vector<EdgeId>& equivalents{compactGraph.getEquivalentOriginalIds(originalEdgeId)};
+    if (!equivalents.empty()) {
+        printf("\t\t\tInterchangeable with edges:");
+        for (EdgeId equivalentId : equivalents) {
+            printf(" %u", equivalentId);
+        }
+        printf("\n");
+    }
+}
 
-        const Edge &edgeInOriginalGraph = compactGraph.originalGraph.edges[compactGraph.getOriginalId(
-                *preimageOfPredArc)];
-        edgeInOriginalGraph.print();
+void Solution::printSpanningTree(const GraphCompacter& compactGraph, const std::vector<EdgeId>& edgeIds) {
+    CostArray treeCosts{generate(0)};
+    size_t printedEdges{0};
+    for (EdgeId edgeId : edgeIds) {
+        const Edge& preimageOfPredArc{compactGraph.compactGraph.edges[edgeId]};
+        addInPlace(treeCosts, preimageOfPredArc.c);
+        printEdgeWithEquivalents(compactGraph, compactGraph.getOriginalId(preimageOfPredArc));
         ++printedEdges;
-        while (printedEdges < compactGraph.compactGraph.nodesCount - 1) {
-            tree = &this->permanents->getElement(tree->predLabelPosition);
-            preimageOfPredArc = &compactGraph.compactGraph.edges[tree->lastArc];
-            addInPlace(treeCosts, preimageOfPredArc->c);
-            const Edge &edgeInOriginalGraph = compactGraph.originalGraph.edges[compactGraph.getOriginalId(
-                    *preimageOfPredArc)];
-            edgeInOriginalGraph.print();
-//printf("\t\t\tEdge: [%u, %u] with c = (%u, %u, %u)\n", preimageOfPredArc->tail, preimageOfPredArc->head, preimageOfPredArc->c[0],  preimageOfPredArc->c[1],  preimageOfPredArc->c[2]);
+    }
+    for (const auto &connectedComponent: *compactGraph.connectedComponents) {
+        for (EdgeId edgeId: connectedComponent.edgeIds) {
+            printEdgeWithEquivalents(compactGraph, edgeId);
             ++printedEdges;
         }
-        for (const auto &connectedComponent: *compactGraph.connectedComponents) {
-            for (EdgeId edgeId: connectedComponent.edgeIds) {
-                const Edge &edgeInOriginalGraph{compactGraph.originalGraph.edges[edgeId]};
-                edgeInOriginalGraph.print();
-                ++printedEdges;
-            }
-        }
-        addInPlace(treeCosts, compactGraph.connectedComponentsCost);
-        printf("\t\tTree with costs: ");
-        printCosts(treeCosts);
-        printf("\n");
-        assert(printedEdges == compactGraph.originalGraph.nodesCount - 1);
     }
-}
\ No newline at end of file
+    addInPlace(treeCosts, compactGraph.connectedComponentsCost);
+    printf("\t\tTree with costs: ");
+    printCosts(treeCosts);
+    printf("\n");
+    assert(printedEdges == compactGraph.originalGraph.nodesCount - 1);
+}
+
+std::vector<EdgeId> Solution::getEdges(size_t treeIndex, size_t edgesCount) const {
+    return this->permanents->getChain(treeIndex, edgesCount);
+}
+
+void Solution::addSpanningTree(const std::vector<EdgeId>& edgeIds) {
+    size_t predIndex = std::numeric_limits<size_t>::max();
+    for (EdgeId edgeId : edgeIds) {
+        size_t index = this->permanents->getCurrentIndex();
+        this->permanents->addElement(predIndex, edgeId);
+        predIndex = index;
+    }
+    this->spanningTreeIndices.push_back(predIndex);
+}
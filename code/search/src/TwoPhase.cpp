@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <chrono>
+
+#include "../../datastructures/includes/graph.h"
+#include "../../preprocessing/includes/Preprocessor.h"
+
+#include "../includes/TwoPhase.h"
+
+using namespace TwoPhase;
+
+TwoPhaseSearch::TwoPhaseSearch(const Graph& G, const Preprocessor& preprocessor):
+        graph{G},
+        bounds{preprocessor},
+        //Every tree is rounded once, so the rounding may use the full approximation factor.
+        rounding(preprocessor.epsilon, 1),
+        sets(G.nodesCount) {
+    for (EdgeId id = 0; id < this->graph.edges.size(); ++id) {
+        if (!this->graph.edges[id].isRed) {
+            this->rankingOrder.push_back(id);
+        }
+    }
+    for (Dimension i = 0; i < DIM; ++i) {
+        this->objectiveOrders[i] = this->rankingOrder;
+        std::stable_sort(this->objectiveOrders[i].begin(), this->objectiveOrders[i].end(), [&G, i](EdgeId lhs, EdgeId rhs) {
+            return G.edges[lhs].c[i] < G.edges[rhs].c[i];
+        });
+    }
+    std::stable_sort(this->rankingOrder.begin(), this->rankingOrder.end(), [this](EdgeId lhs, EdgeId rhs) {
+        const CostArray& cLhs{this->graph.edges[lhs].c};
+        const CostArray& cRhs{this->graph.edges[rhs].c};
+        return this->rankingKey(cLhs) < this->rankingKey(cRhs) ||
+               (this->rankingKey(cLhs) == this->rankingKey(cRhs) && lexSmaller(cLhs, cRhs));
+    });
+}
+
+uint64_t TwoPhaseSearch::rankingKey(const CostArray& c) const {
+    uint64_t key{0};
+    for (Dimension i = 0; i < DIM; ++i) {
+        key += c[i];
+    }
+    return key;
+}
+
+bool TwoPhaseSearch::completeTree(const std::vector<EdgeId>& order, size_t forcedCount,
+                                  const boost::dynamic_bitset<>& excluded, std::vector<EdgeId>& tree) {
+    assert(tree.size() >= forcedCount);
+    this->sets.reset();
+    tree.resize(forcedCount);
+    for (EdgeId id : tree) {
+        const Edge& edge{this->graph.edges[id]};
+        this->sets.unite(edge.tail, edge.head);
+    }
+    for (EdgeId id : order) {
+        if (tree.size() + 1 == this->graph.nodesCount) {
+            break;
+        }
+        if (excluded[id]) {
+            continue;
+        }
+        const Edge& edge{this->graph.edges[id]};
+        if (this->sets.unite(edge.tail, edge.head)) {
+            tree.push_back(id);
+        }
+    }
+    return tree.size() + 1 == this->graph.nodesCount;
+}
+
+bool TwoPhaseSearch::solve(Subproblem& subproblem) {
+    if (!this->completeTree(this->rankingOrder, subproblem.forcedCount, subproblem.excluded, subproblem.tree)) {
+        return false;
+    }
+    subproblem.c = generate(0);
+    for (EdgeId id : subproblem.tree) {
+        addInPlace(subproblem.c, this->graph.edges[id].c);
+    }
+    subproblem.key = this->rankingKey(subproblem.c);
+    for (Dimension i = 0; i < DIM; ++i) {
+        this->treeBuffer.assign(subproblem.tree.begin(), subproblem.tree.begin() + subproblem.forcedCount);
+        this->completeTree(this->objectiveOrders[i], subproblem.forcedCount, subproblem.excluded, this->treeBuffer);
+        subproblem.lowerBound[i] = 0;
+        for (EdgeId id : this->treeBuffer) {
+            subproblem.lowerBound[i] += this->graph.edges[id].c[i];
+        }
+    }
+    return true;
+}
+
+bool TwoPhaseSearch::pruned(const CostArray& lowerBound) const {
+    if (!this->bounds.withinBudget(lowerBound)) {
+        return true;
+    }
+    const CostArray rounded = this->rounding.round(lowerBound);
+    for (const RoundedTree& tree : this->front) {
+        if (dominates(tree.rounded, rounded)) {
+            return true;
+        }
+    }
+    //The trees behind the dominance bound and the upper bound set are not necessarily part of an approximated front.
+    return this->rounding.exact &&
+           (weakDominates(this->bounds.dominanceBound, lowerBound) || this->bounds.upperBoundDominance(lowerBound));
+}
+
+void TwoPhaseSearch::insert(const CostArray& c, const std::vector<EdgeId>& edges) {
+    if (!this->bounds.withinBudget(c)) {
+        return;
+    }
+    const CostArray rounded = this->rounding.round(c);
+    for (const RoundedTree& tree : this->front) {
+        if (dominates(tree.rounded, rounded)) {
+            return;
+        }
+    }
+    this->front.erase(std::remove_if(this->front.begin(), this->front.end(), [&rounded](const RoundedTree& tree) {
+        return dominates(rounded, tree.rounded);
+    }), this->front.end());
+    this->front.push_back(RoundedTree{c, rounded, edges});
+}
+
+Solution TwoPhaseSearch::run() {
+    if (this->graph.arcsCount == 0) {
+        return Solution();
+    }
+    Solution solution;
+    auto start = std::chrono::high_resolution_clock::now();
+    const boost::dynamic_bitset<> noExclusions(this->graph.edges.size());
+    //Phase one: the weighted sum MSTs are supported efficient trees.
+    if (!collectSupportedTrees(this->graph, [this](const CostArray& c, const std::vector<EdgeId>& edges) {
+        this->insert(c, edges);
+    })) {
+        solution.trees = 0;
+        return solution;
+    }
+
+    //Phase two: rank the spanning trees, every extracted subproblem is split into the subproblems that contain the
+    //forced edges plus a prefix of the remaining edges of its tree but not the next one.
+    std::vector<Subproblem> heap;
+    Subproblem root;
+    root.excluded = noExclusions;
+    if (this->solve(root) && !this->pruned(root.lowerBound)) {
+        heap.push_back(std::move(root));
+        ++this->insertions;
+    }
+    while (!heap.empty()) {
+        if (this->anytime.limitReached(0, this->extractions, start)) {
+            solution.complete = false;
+            break;
+        }
+        std::pop_heap(heap.begin(), heap.end(), SubproblemComparison());
+        Subproblem current{std::move(heap.back())};
+        heap.pop_back();
+        ++this->extractions;
+        //The front might have grown since the subproblem was inserted into the heap.
+        if (this->pruned(current.lowerBound)) {
+            ++this->prunedSubproblems;
+            continue;
+        }
+        this->insert(current.c, current.tree);
+        for (size_t k = current.forcedCount; k < current.tree.size(); ++k) {
+            Subproblem child;
+            child.tree.assign(current.tree.begin(), current.tree.begin() + k);
+            child.forcedCount = k;
+            child.excluded = current.excluded;
+            child.excluded[current.tree[k]] = true;
+            if (!this->solve(child)) {
+                continue;
+            }
+            if (this->pruned(child.lowerBound)) {
+                ++this->prunedSubproblems;
+                continue;
+            }
+            heap.push_back(std::move(child));
+            std::push_heap(heap.begin(), heap.end(), SubproblemComparison());
+            ++this->insertions;
+        }
+    }
+
+    emitFront(this->front, this->anytime, this->bounds.costsOnly, solution);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+    solution.time = duration.count();
+    this->storeStatistics(solution);
+    return solution;
+}
+
+void TwoPhaseSearch::storeStatistics(Solution& sol) const {
+    sol.extractions = this->extractions;
+    sol.insertions = this->insertions;
+    sol.prunedTrees = this->prunedSubproblems;
+}